@@ -0,0 +1,177 @@
+#ifndef BENCHMARKS_BENCHMARK_H
+#define BENCHMARKS_BENCHMARK_H
+
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "spdlog/spdlog.h"
+#include "vocabulary/translation.h"
+#include "vocabulary/word.h"
+
+// helpers shared by the benchmark executables
+namespace benchmarks {
+
+using Clock = std::chrono::steady_clock;
+
+inline double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * Calls `function` `iterations` times
+ * @return average duration of one call in nanoseconds
+ */
+template <typename Function>
+double measureNs(size_t iterations, Function&& function)
+{
+    auto const start{Clock::now()};
+    for (size_t i{0}; i < iterations; ++i) {
+        function(i);
+    }
+    return secondsSince(start) * 1e9 / static_cast<double>(iterations);
+}
+
+// keeps the compiler from dropping the computation of the value
+template <typename T>
+void doNotOptimize(T const& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// peak resident set size of the process since it has been started (or exec'ed)
+inline size_t peakRssKiB()
+{
+    auto const status{std::fopen("/proc/self/status", "r")};
+    if (!status) {
+        return 0;
+    }
+    size_t result{0};
+    char line[256];
+    while (std::fgets(line, sizeof(line), status)) {
+        if (std::sscanf(line, "VmHWM: %zu kB", &result) == 1) {
+            break;
+        }
+    }
+    std::fclose(status);
+    return result;
+}
+
+struct ChildRun {
+    double seconds{};
+    size_t peak_rss_kib{};
+    bool succeeded{};
+};
+
+/**
+ * Reports the result of the operation measured in the child process,
+ * see runChild()
+ */
+inline int reportToParent(Clock::time_point start)
+{
+    std::cout << std::format("{} {}\n", secondsSince(start), peakRssKiB());
+    return 0;
+}
+
+/**
+ * Runs this executable again with the arguments, so the peak memory of one operation
+ * is measured in a fresh process. The child measures the operation and reports it by
+ * reportToParent().
+ */
+inline ChildRun runChild(std::vector<std::string> arguments)
+{
+    arguments.insert(arguments.begin(), "/proc/self/exe");
+    std::vector<char*> argv;
+    for (auto& argument : arguments) {
+        argv.push_back(argument.data());
+    }
+    argv.push_back(nullptr);
+
+    ChildRun result;
+    int output[2];
+    if (pipe(output) != 0) {
+        return result;
+    }
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, output[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, output[0]);
+    pid_t pid{};
+    auto const spawned{posix_spawn(&pid, argv[0], &actions, nullptr, argv.data(), environ)};
+    posix_spawn_file_actions_destroy(&actions);
+    close(output[1]);
+    if (spawned != 0) {
+        close(output[0]);
+        return result;
+    }
+
+    std::string report;
+    char buffer[256];
+    for (ssize_t n{}; (n = read(output[0], buffer, sizeof(buffer))) > 0;) {
+        report.append(buffer, static_cast<size_t>(n));
+    }
+    close(output[0]);
+
+    int status{};
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return result;
+    }
+    result.succeeded = std::sscanf(report.c_str(), "%lf %zu", &result.seconds,
+                                   &result.peak_rss_kib) == 2;
+    return result;
+}
+
+/**
+ * Distinct lowercase words of 4-12 letters, the same for the same seed
+ */
+inline std::vector<std::string> makeWords(size_t count, uint32_t seed = 42)
+{
+    std::mt19937 random{seed};
+    std::uniform_int_distribution<size_t> length{4, 12};
+    std::uniform_int_distribution<int> letter{'a', 'z'};
+
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (size_t i{0}; i < count; ++i) {
+        std::string word(length(random), ' ');
+        for (auto& c : word) {
+            c = static_cast<char>(letter(random));
+        }
+        // the suffix makes the words distinct
+        result.push_back(std::format("{}{}", word, i));
+    }
+    return result;
+}
+
+// vocabulary entry with two variants and one example, as a typical imported line has
+inline vocabulary::Word makeEntry(std::string_view word)
+{
+    return {word,
+            vocabulary::Translation{{std::format("{} variant", word), std::format("other {}", word)},
+                                    {std::format("an example sentence with {}", word)}}};
+}
+
+// value of the argument or `fallback` if there is no such argument
+inline size_t argument(int argc, char* argv[], int index, size_t fallback)
+{
+    return index < argc ? static_cast<size_t>(std::strtoull(argv[index], nullptr, 10))
+                        : fallback;
+}
+
+// the benchmarks print tables, so the info messages of the code under test are muted
+inline void init() { spdlog::set_level(spdlog::level::warn); }
+
+}  // namespace benchmarks
+
+#endif  // BENCHMARKS_BENCHMARK_H
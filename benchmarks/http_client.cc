@@ -0,0 +1,109 @@
+/**
+ * Requests per second of HttpClient against a local stand-in server: with the connections
+ * kept alive and pooled, and with a new connection per request (the server closes every
+ * one), one request at a time and several in flight. The chunked responses are decoded while
+ * the chunks arrive, every chunk is written separately.
+ *
+ * usage: http_client_benchmark [requests count (5000)] [requests in flight (8)]
+ */
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "benchmarks/benchmark.h"
+#include "common/config/config.h"
+#include "network/http/client/nttp_client.h"
+#include "tests/http_server.h"
+
+namespace {
+
+// a typical translation response
+constexpr std::string_view kBody{
+    R"({"word":"example","translation":["an example","a sample"],"examples":["for example"]})"};
+
+struct Run {
+    double requests_per_second{};
+    size_t connections{};  // opened by the client
+    size_t errors{};
+};
+
+Run run(tests::HttpServer::Response const& response, size_t count, size_t in_flight)
+{
+    tests::HttpServer server{[&response](std::string_view) { return response; }};
+    common::Config::instance().setValue<int>(common::ConfigId::kHttpConnectionsPerHost,
+                                             static_cast<int>(in_flight));
+    network::HttpClient client;
+
+    std::atomic<size_t> sent{0};
+    std::atomic<size_t> finished{0};
+    std::atomic<size_t> errors{0};
+    std::promise<void> done;
+    // every finished request sends the next one, so `in_flight` requests are sent at once;
+    // the targets differ, identical requests in flight would be coalesced
+    std::function<void()> send = [&]() {
+        auto const i{sent++};
+        if (i >= count) {
+            return;
+        }
+        client.sendRequest("127.0.0.1", server.port(), std::format("/translate/{}", i), "GET",
+                           {}, {}, [&](std::string const& body, std::string const& error) {
+                               if (!error.empty() || body != kBody) {
+                                   ++errors;
+                               }
+                               send();
+                               // the last one, nothing is used after it
+                               if (++finished == count) {
+                                   done.set_value();
+                               }
+                           });
+    };
+
+    auto const start{benchmarks::Clock::now()};
+    for (size_t i{0}; i < in_flight; ++i) {
+        send();
+    }
+    done.get_future().wait();
+    return {static_cast<double>(count) / benchmarks::secondsSince(start),
+            client.connectionsStatistic().opened, errors.load()};
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    benchmarks::init();
+    auto const count{benchmarks::argument(argc, argv, 1, 5000)};
+    auto const in_flight{std::max<size_t>(1, benchmarks::argument(argc, argv, 2, 8))};
+
+    std::cout << std::format("{} requests\n", count);
+    std::cout << std::format("{:>28} {:>10} {:>12}\n", "", "req/s", "connections");
+    using tests::HttpServer;
+    std::pair<char const*, HttpServer::Response> const responses[]{
+        {"pooled", HttpServer::ok(kBody)},
+        {"unpooled", HttpServer::ok(kBody, true)},
+        {"pooled chunked", HttpServer::chunked({kBody.substr(0, 20), kBody.substr(20, 40),
+                                                kBody.substr(60)})},
+    };
+    size_t errors{0};
+    for (auto const concurrency : {size_t{1}, in_flight}) {
+        for (auto const& [name, response] : responses) {
+            auto const result{run(response, count, concurrency)};
+            std::cout << std::format("{:>28} {:>10.0f} {:>12}\n",
+                                     std::format("{}, {} in flight", name, concurrency),
+                                     result.requests_per_second, result.connections);
+            errors += result.errors;
+        }
+        if (in_flight == 1) {
+            break;
+        }
+    }
+    if (errors != 0) {
+        std::cout << std::format("{} requests failed\n", errors);
+        return 1;
+    }
+    return 0;
+}
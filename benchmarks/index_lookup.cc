@@ -0,0 +1,60 @@
+/**
+ * Cost of Vocabulary::find() as the vocabulary grows. The lookup goes through the
+ * hash index, so it's expected to be flat; the linear scan the index has replaced is
+ * measured for reference.
+ *
+ * usage: index_lookup_benchmark [max words count (200000)] [lookups per size (1000000)]
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+#include "benchmarks/benchmark.h"
+#include "vocabulary/vocabulary.h"
+
+int main(int argc, char* argv[])
+{
+    benchmarks::init();
+    auto const max_count{benchmarks::argument(argc, argv, 1, 200'000)};
+    auto const lookups{benchmarks::argument(argc, argv, 2, 1'000'000)};
+
+    auto const words{benchmarks::makeWords(max_count)};
+    std::cout << std::format("{:>10} {:>16} {:>16}\n", "words", "index, ns", "linear scan, ns");
+
+    std::vector<size_t> counts;
+    for (size_t count{1'000}; count < max_count; count *= 10) {
+        counts.push_back(count);
+    }
+    counts.push_back(max_count);
+
+    for (auto const count : counts) {
+        vocabulary::Vocabulary vocabulary;
+        std::vector<vocabulary::Word> entries;
+        for (size_t i{0}; i < count; ++i) {
+            entries.push_back(benchmarks::makeEntry(words[i]));
+        }
+        vocabulary.addWords(std::move(entries));
+
+        // the same random order of the looked up words for every size
+        std::mt19937 random{7};
+        std::vector<size_t> order(lookups);
+        std::uniform_int_distribution<size_t> index{0, count - 1};
+        std::ranges::generate(order, [&] { return index(random); });
+
+        auto const index_ns{benchmarks::measureNs(lookups, [&](size_t i) {
+            benchmarks::doNotOptimize(vocabulary.find(words[order[i]]));
+        })};
+
+        // the scan is O(n), so it's measured by fewer lookups
+        auto const scans{std::max<size_t>(1, lookups * 1'000 / count / 10)};
+        auto const scan_ns{benchmarks::measureNs(scans, [&](size_t i) {
+            auto const& word{words[order[i]]};
+            auto const it{std::find(words.begin(), words.begin() + count, word)};
+            benchmarks::doNotOptimize(it);
+        })};
+
+        std::cout << std::format("{:>10} {:>16.1f} {:>16.1f}\n", count, index_ns, scan_ns);
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * Streaming (SAX) json import of Vocabulary::importFromJsonFile() against parsing the
+ * whole file into a nlohmann::json DOM and converting it by from_json(), as the import
+ * did before. Every import runs in a separate process, so its peak memory is not hidden
+ * by the previous ones; "none" is the baseline of the process which imports nothing.
+ *
+ * usage: json_import_benchmark [words count (100000)] [runs (3)]
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "benchmarks/benchmark.h"
+#include "vocabulary/vocabulary.h"
+
+#include "nlohmann/json.hpp"
+
+namespace {
+
+int import(std::string_view mode, std::filesystem::path const& path)
+{
+    auto const start{benchmarks::Clock::now()};
+    if (mode == "sax") {
+        vocabulary::Vocabulary vocabulary;
+        vocabulary.importFromJsonFile(path);
+    } else if (mode == "dom") {
+        std::ifstream input(path);
+        auto const json = nlohmann::json::parse(input);
+        std::vector<std::shared_ptr<vocabulary::Word>> words;
+        vocabulary::from_json(json.at("vocabulary"), words);
+        benchmarks::doNotOptimize(words.size());
+    }
+    return benchmarks::reportToParent(start);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    benchmarks::init();
+    if (argc == 4 && std::string_view{argv[1]} == "import") {
+        return import(argv[2], argv[3]);
+    }
+
+    auto const count{benchmarks::argument(argc, argv, 1, 100'000)};
+    auto const runs{benchmarks::argument(argc, argv, 2, 3)};
+
+    auto const dir{std::filesystem::temp_directory_path() / "vocabulator_benchmark"};
+    std::filesystem::create_directories(dir);
+    auto const path{dir / "vocabulary.json"};
+    {
+        vocabulary::Vocabulary vocabulary;
+        std::vector<vocabulary::Word> entries;
+        for (auto const& word : benchmarks::makeWords(count)) {
+            entries.push_back(benchmarks::makeEntry(word));
+        }
+        vocabulary.addWords(std::move(entries));
+        vocabulary.exportToJsonFile(path);
+    }
+
+    std::cout << std::format("{} words, {} KiB file\n{:>6} {:>12} {:>14}\n", count,
+                             std::filesystem::file_size(path) / 1024, "import", "time, ms",
+                             "peak RSS, KiB");
+    for (auto const mode : {"none", "dom", "sax"}) {
+        // the best of the runs, the file is in the page cache after the first one
+        benchmarks::ChildRun best;
+        for (size_t i{0}; i < runs; ++i) {
+            auto const run{benchmarks::runChild({"import", mode, path.string()})};
+            if (!run.succeeded) {
+                std::cerr << std::format("{} import of {} failed\n", mode, path.string());
+                return 1;
+            }
+            if (i == 0 || run.seconds < best.seconds) {
+                best = run;
+            }
+        }
+        std::cout << std::format("{:>6} {:>12.1f} {:>14}\n", mode, best.seconds * 1e3,
+                                 best.peak_rss_kib);
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * Throughput of the tools::simd scanners for every implementation supported by the CPU,
+ * std::string_view (memchr, find_first_not_of) is measured for reference:
+ * - find: the delimiter is at the end of a long string;
+ * - first/last not blank: a long run of blanks;
+ * - split: tokens of a typical vocabulary line length.
+ *
+ * usage: simd_scan_benchmark [string size in KiB (1024)] [runs (200)]
+ */
+
+#include <iostream>
+#include <string>
+
+#include "benchmarks/benchmark.h"
+#include "tools/simd_scan.h"
+#include "tools/string_utils.h"
+
+int main(int argc, char* argv[])
+{
+    benchmarks::init();
+    auto const size{benchmarks::argument(argc, argv, 1, 1024) * 1024};
+    auto const runs{benchmarks::argument(argc, argv, 2, 200)};
+
+    auto const letters{std::string(size - 1, 'a') + '|'};
+    auto const blanks{'a' + std::string(size - 2, ' ') + 'a'};
+    std::string tokens;
+    while (tokens.size() < size) {
+        tokens += "some words of a line;";
+    }
+    auto const megabytes{static_cast<double>(size) / (1024 * 1024)};
+    auto const mbPerSecond = [megabytes](double ns) { return megabytes / (ns / 1e9); };
+
+    std::cout << std::format("{} KiB strings, MiB/s\n", size / 1024);
+    std::cout << std::format("{:>16} {:>10} {:>16} {:>16} {:>10}\n", "", "find",
+                             "first not blank", "last not blank", "split");
+
+    // the blank runs start and end with a letter, so the scans don't stop on the first byte
+    auto const blanks_from{std::string_view{blanks}.substr(1)};
+    auto const blanks_to{std::string_view{blanks}.substr(0, size - 1)};
+    auto const measure = [runs, &mbPerSecond](auto&& scan) {
+        return mbPerSecond(
+            benchmarks::measureNs(runs, [&scan](size_t) { benchmarks::doNotOptimize(scan()); }));
+    };
+
+    using tools::simd::Implementation;
+    for (auto const implementation :
+         {Implementation::kScalar, Implementation::kSse2, Implementation::kAvx2}) {
+        if (!tools::simd::setImplementation(implementation)) {
+            continue;
+        }
+        std::cout << std::format(
+            "{:>16} {:>10.1f} {:>16.1f} {:>16.1f} {:>10.1f}\n", tools::simd::name(implementation),
+            measure([&] { return tools::simd::find(letters, '|'); }),
+            measure([&] { return tools::simd::findFirstNotBlank(blanks_from); }),
+            measure([&] { return tools::simd::findLastNotBlank(blanks_to); }),
+            measure([&] { return tools::string_utils::splitView(tokens, ';').size(); }));
+    }
+
+    std::cout << std::format("{:>16} {:>10.1f} {:>16.1f} {:>16.1f} {:>10}\n",
+                             "std::string_view",
+                             measure([&] { return std::string_view{letters}.find('|'); }),
+                             measure([&] { return blanks_from.find_first_not_of(" \t"); }),
+                             measure([&] { return blanks_to.find_last_not_of(" \t"); }), "-");
+    return 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * Throughput of the text vocabulary parsing: Word::parse() line by line and
+ * TextImporter::parse() on one worker and on all the hardware threads.
+ *
+ * usage: text_parse_benchmark [lines count (200000)] [runs (5)]
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "benchmarks/benchmark.h"
+#include "tools/string_utils.h"
+#include "vocabulary/text_importer.h"
+#include "vocabulary/word.h"
+
+int main(int argc, char* argv[])
+{
+    benchmarks::init();
+    auto const count{benchmarks::argument(argc, argv, 1, 200'000)};
+    auto const runs{benchmarks::argument(argc, argv, 2, 5)};
+
+    // typical lines of an exported vocabulary, with the spaces around the fields
+    std::string text;
+    for (auto const& word : benchmarks::makeWords(count)) {
+        text += std::format("| {} | {} variant; other {} ; third | an example with {} |\n",
+                            word, word, word, word);
+    }
+    auto const megabytes{static_cast<double>(text.size()) / (1024 * 1024)};
+
+    auto const lines_ns{benchmarks::measureNs(runs, [&text](size_t) {
+        tools::string_utils::forEachToken(text, '\n', [](std::string_view line) {
+            benchmarks::doNotOptimize(vocabulary::Word::parse(line));
+        });
+    })};
+
+    auto const importNs = [&text, runs](size_t threads) {
+        return benchmarks::measureNs(runs, [&text, threads](size_t) {
+            benchmarks::doNotOptimize(
+                vocabulary::TextImporter::parse(text, ';', '|', threads).words.size());
+        });
+    };
+    auto const threads{std::max(1U, std::thread::hardware_concurrency())};
+
+    std::cout << std::format("{} lines, {:.1f} MiB\n", count, megabytes);
+    std::cout << std::format("{:>28} {:>10}\n", "", "MiB/s");
+    std::cout << std::format("{:>28} {:>10.1f}\n", "Word::parse()",
+                             megabytes / (lines_ns / 1e9));
+    std::cout << std::format("{:>28} {:>10.1f}\n", "TextImporter, 1 thread",
+                             megabytes / (importNs(1) / 1e9));
+    if (threads > 1) {
+        std::cout << std::format("{:>28} {:>10.1f}\n",
+                                 std::format("TextImporter, {} threads", threads),
+                                 megabytes / (importNs(threads) / 1e9));
+    }
+    return 0;
+}
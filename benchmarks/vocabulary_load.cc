@@ -0,0 +1,81 @@
+/**
+ * Load time and peak RSS of the binary vocabulary format against the json one.
+ * Every load runs in a separate process, so its peak memory is not hidden by the
+ * previous ones; "none" is the baseline of the process which loads nothing.
+ *
+ * usage: vocabulary_load_benchmark [words count (100000)] [runs (3)]
+ */
+
+#include <filesystem>
+#include <iostream>
+
+#include "benchmarks/benchmark.h"
+#include "vocabulary/vocabulary.h"
+
+namespace {
+
+int load(std::string_view format, std::filesystem::path const& path)
+{
+    auto const start{benchmarks::Clock::now()};
+    vocabulary::Vocabulary vocabulary;
+    if (format == "json") {
+        vocabulary.importFromJsonFile(path);
+    } else if (format == "bin") {
+        vocabulary.importFromBinFile(path);
+    }
+    return benchmarks::reportToParent(start);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    benchmarks::init();
+    if (argc == 4 && std::string_view{argv[1]} == "load") {
+        return load(argv[2], argv[3]);
+    }
+
+    auto const count{benchmarks::argument(argc, argv, 1, 100'000)};
+    auto const runs{benchmarks::argument(argc, argv, 2, 3)};
+
+    auto const dir{std::filesystem::temp_directory_path() / "vocabulator_benchmark"};
+    std::filesystem::create_directories(dir);
+    auto const json_path{dir / "vocabulary.json"};
+    auto const bin_path{dir / "vocabulary.bin"};
+    {
+        vocabulary::Vocabulary vocabulary;
+        std::vector<vocabulary::Word> entries;
+        for (auto const& word : benchmarks::makeWords(count)) {
+            entries.push_back(benchmarks::makeEntry(word));
+        }
+        vocabulary.addWords(std::move(entries));
+        vocabulary.exportToJsonFile(json_path);
+        vocabulary.exportToBinFile(bin_path);
+    }
+
+    std::cout << std::format("{} words\n{:>8} {:>12} {:>10} {:>14}\n", count, "format",
+                             "file, KiB", "load, ms", "peak RSS, KiB");
+    for (auto const& [format, path] : {std::pair{"none", json_path}, std::pair{"json", json_path},
+                                       std::pair{"bin", bin_path}}) {
+        // the best of the runs, the file is in the page cache after the first one
+        benchmarks::ChildRun best;
+        for (size_t i{0}; i < runs; ++i) {
+            auto const run{benchmarks::runChild({"load", format, path.string()})};
+            if (!run.succeeded) {
+                std::cerr << std::format("loading of {} failed\n", path.string());
+                return 1;
+            }
+            if (i == 0 || run.seconds < best.seconds) {
+                best = run;
+            }
+        }
+        auto const file_kib{std::string_view{format} == "none"
+                                ? 0
+                                : std::filesystem::file_size(path) / 1024};
+        std::cout << std::format("{:>8} {:>12} {:>10.1f} {:>14}\n", format, file_kib,
+                                 best.seconds * 1e3, best.peak_rss_kib);
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * Memory and scan cost of the vocabulary words kept in WordStore against the words kept
+ * as separately allocated Word objects, as the vocabulary did before. The memory is the
+ * heap growth (mallinfo2) of building the words, the scan counts the known words.
+ *
+ * usage: word_store_benchmark [words count (200000)] [scans (100)]
+ */
+
+#include <malloc.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+#include "benchmarks/benchmark.h"
+#include "vocabulary/word_store.h"
+
+namespace {
+
+size_t heapBytes() { return mallinfo2().uordblks; }
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    benchmarks::init();
+    auto const count{benchmarks::argument(argc, argv, 1, 200'000)};
+    auto const scans{benchmarks::argument(argc, argv, 2, 100)};
+    auto constexpr kTargetRetentionRate{2};
+
+    auto const words{benchmarks::makeWords(count)};
+    std::vector<vocabulary::Word> entries;
+    entries.reserve(count);
+    for (size_t i{0}; i < count; ++i) {
+        entries.push_back(benchmarks::makeEntry(words[i]));
+        for (size_t k{0}; k < i % 5; ++k) {
+            entries.back().know();
+        }
+    }
+
+    auto heap{heapBytes()};
+    std::vector<std::shared_ptr<vocabulary::Word>> objects;
+    objects.reserve(count);
+    for (auto const& entry : entries) {
+        auto const& translation{entry.translation()};
+        objects.push_back(std::make_shared<vocabulary::Word>(
+            entry.word(), vocabulary::Translation{translation.variants(), translation.examples()},
+            entry.dontKnowNumber(), entry.knowNumber()));
+    }
+    auto const objects_bytes{heapBytes() - heap};
+
+    heap = heapBytes();
+    vocabulary::WordStore store;
+    std::vector<vocabulary::WordStore::Handle> handles;
+    handles.reserve(count);
+    for (auto const& entry : entries) {
+        handles.push_back(store.add(entry));
+    }
+    auto const store_bytes{heapBytes() - heap};
+
+    auto const objects_ns{benchmarks::measureNs(scans, [&](size_t) {
+        benchmarks::doNotOptimize(std::ranges::count_if(objects, [](auto const& w) {
+            return w->retentionRate() > kTargetRetentionRate;
+        }));
+    })};
+    auto const store_ns{benchmarks::measureNs(scans, [&](size_t) {
+        benchmarks::doNotOptimize(store.countKnown(kTargetRetentionRate));
+    })};
+
+    auto const perWord = [count](double value) { return value / static_cast<double>(count); };
+    std::cout << std::format("{} words\n", count);
+    std::cout << std::format("{:>22} {:>14} {:>18}\n", "", "bytes per word",
+                             "known words scan, ms");
+    std::cout << std::format("{:>22} {:>14.1f} {:>18.3f}\n", "shared_ptr<Word>",
+                             perWord(static_cast<double>(objects_bytes)), objects_ns / 1e6);
+    std::cout << std::format("{:>22} {:>14.1f} {:>18.3f}\n", "WordStore",
+                             perWord(static_cast<double>(store_bytes)), store_ns / 1e6);
+    return 0;
+}
@@ -34,6 +34,31 @@ Config::Config()
     // for retention rate in percentage it would be 85 (85% of words should be known)
     // for retention rate as "know" - "don't know" difference it would be 3 (3 more "know" than "don't know")
     values_[ConfigId::kRetentionRateForKnownWord] = {"kRetentionRateForKnownWord", ConfigType::kInt, "", "3"};
+    // max amount of words which are learnt at the same time
+    values_[ConfigId::kLearningBatchSize] = {"kLearningBatchSize", ConfigType::kInt, "", "15"};
+    // amount of journal records after which the journal is compacted into the vocabulary file (0 - never)
+    values_[ConfigId::kJournalCompactionThreshold] = {"kJournalCompactionThreshold", ConfigType::kInt, "", "500"};
+    // seconds between background saves of the vocabulary file (0 - no autosave)
+    values_[ConfigId::kAutosaveInterval] = {"kAutosaveInterval", ConfigType::kInt, "", "300"};
+    // worker threads which parse text vocabulary files (0 - one per CPU core)
+    values_[ConfigId::kImportThreads] = {"kImportThreads", ConfigType::kInt, "", "0"};
+    // KiB of the cached translations kept in memory and max size of the cache file
+    values_[ConfigId::kTranslationCacheMemoryLimit] = {"kTranslationCacheMemoryLimit", ConfigType::kInt, "", "1024"};
+    values_[ConfigId::kTranslationCacheFileLimit] = {"kTranslationCacheFileLimit", ConfigType::kInt, "", "16384"};
+    // bulk translation: words per request and requests sent to the server at once
+    values_[ConfigId::kTranslationBatchSize] = {"kTranslationBatchSize", ConfigType::kInt, "", "20"};
+    values_[ConfigId::kTranslationRequestsInFlight] = {"kTranslationRequestsInFlight", ConfigType::kInt, "", "4"};
+    // keep-alive connections of the HTTP client: max per host and seconds an idle one is kept
+    values_[ConfigId::kHttpConnectionsPerHost] = {"kHttpConnectionsPerHost", ConfigType::kInt, "", "4"};
+    values_[ConfigId::kHttpKeepAliveTimeout] = {"kHttpKeepAliveTimeout", ConfigType::kInt, "", "30"};
+    // seconds to connect to the host and to wait for the next bytes of the response (a local
+    // model server may think for a while before the first token)
+    values_[ConfigId::kHttpConnectTimeout] = {"kHttpConnectTimeout", ConfigType::kInt, "", "5"};
+    values_[ConfigId::kHttpReadTimeout] = {"kHttpReadTimeout", ConfigType::kInt, "", "120"};
+    // retries of a failed idempotent request and milliseconds before the first one (the delay
+    // is doubled for every next retry and jittered)
+    values_[ConfigId::kHttpRetryCount] = {"kHttpRetryCount", ConfigType::kInt, "", "2"};
+    values_[ConfigId::kHttpRetryBackoff] = {"kHttpRetryBackoff", ConfigType::kInt, "", "500"};
 
     // float -------------
     values_[ConfigId::kScaleFactor] = {"kScaleFactor", ConfigType::kInt, "", "1.0"};
@@ -45,13 +70,24 @@ Config::Config()
     values_[ConfigId::kFontPath] = {"kFontPath", ConfigType::kString, "", "assets/fonts/Ubuntu-R.ttf"};
     values_[ConfigId::kVocabularyPathMd] = {"kVocabularyPathMd", ConfigType::kString, "", "assets/vocabulary.md"};
     values_[ConfigId::kVocabularyPathJson] = {"kVocabularyPathJson", ConfigType::kString, "", "assets/vocabulary.json"};
+    values_[ConfigId::kVocabularyPathJournal] = {"kVocabularyPathJournal", ConfigType::kString, "", "assets/vocabulary.journal"};
+    // shared read-only vocabulary, the words of which are added without translation requests
+    values_[ConfigId::kVocabularyPathSnapshot] = {"kVocabularyPathSnapshot", ConfigType::kString, "", "assets/vocabulary.snapshot"};
+    // spaced repetition algorithm: "sm2" or "fsrs"
+    values_[ConfigId::kScheduler] = {"kScheduler", ConfigType::kString, "", "sm2"};
     values_[ConfigId::kDefaultServer] = {"kDefaultServer", ConfigType::kString, "", "localhost"};
     values_[ConfigId::kDefaultPort] = {"kDefaultPort", ConfigType::kString, "", "1234"};
     values_[ConfigId::kDefaultTarget] = {"kDefaultTarget", ConfigType::kString, "", "/v1/chat/completions"};
     values_[ConfigId::kDefaultMethod] = {"kDefaultMethod", ConfigType::kString, "", "POST"};
+    // model requested from the translation server (empty - server default), a part of the translation cache key
+    values_[ConfigId::kTranslationModel] = {"kTranslationModel", ConfigType::kString, "", ""};
+    // empty - translations are cached in memory only
+    values_[ConfigId::kTranslationCachePath] = {"kTranslationCachePath", ConfigType::kString, "", "assets/translation_cache.bin"};
 
     // // bool -------------
     values_[ConfigId::kWindowResizable] = {"kWindowResizable", ConfigType::kBool, "", "true"};
+    // the translation is shown while it's being generated ("stream": true)
+    values_[ConfigId::kTranslationStreaming] = {"kTranslationStreaming", ConfigType::kBool, "", "true"};
 }
 
 void Config::loadFromFile(std::filesystem::path const& file_path)
@@ -32,6 +32,20 @@ enum class ConfigId {
     kStatusMessageTimer,
     // vocabulary config --------------------------------------------
     kRetentionRateForKnownWord,
+    kLearningBatchSize,
+    kJournalCompactionThreshold,
+    kAutosaveInterval,
+    kImportThreads,
+    kTranslationCacheMemoryLimit,
+    kTranslationCacheFileLimit,
+    kTranslationBatchSize,
+    kTranslationRequestsInFlight,
+    kHttpConnectionsPerHost,
+    kHttpKeepAliveTimeout,
+    kHttpConnectTimeout,
+    kHttpReadTimeout,
+    kHttpRetryCount,
+    kHttpRetryBackoff,
 
     // float ---------------------------------------------------------
     // layout config ------------------------------------------------
@@ -44,13 +58,19 @@ enum class ConfigId {
     kFontPath,
     kVocabularyPathMd,
     kVocabularyPathJson,
+    kVocabularyPathJournal,
+    kVocabularyPathSnapshot,
+    kScheduler,
     kDefaultServer,
     kDefaultPort,
     kDefaultTarget,
     kDefaultMethod,
+    kTranslationModel,
+    kTranslationCachePath,
 
     // bool -------------
     kWindowResizable,
+    kTranslationStreaming,
 };
 
 enum class ConfigType {
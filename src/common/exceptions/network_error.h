@@ -0,0 +1,18 @@
+#ifndef COMMON_EXCEPTIONS_NETWORK_ERROR_H
+#define COMMON_EXCEPTIONS_NETWORK_ERROR_H
+
+#include <stdexcept>
+#include <string>
+
+class NetworkError : public std::runtime_error {
+public:
+    explicit NetworkError(std::string const& msg)
+        : std::runtime_error(msg)
+    {}
+
+    explicit NetworkError(char const* msg)
+        : std::runtime_error(msg)
+    {}
+};
+
+#endif  // COMMON_EXCEPTIONS_NETWORK_ERROR_H
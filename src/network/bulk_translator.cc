@@ -0,0 +1,205 @@
+#include "network/bulk_translator.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "network/chat_completion.h"
+#include "network/http/client/nttp_client.h"
+#include "spdlog/spdlog.h"
+#include "tools/string_utils.h"
+
+namespace network {
+
+std::string_view const BulkTranslator::kPrompt{
+    "Ты переводчик русского и английского языков.\n"
+    "Тебе присылают список английских слов и словосочетаний, по одному в строке. "
+    "Для каждого из них ты должен предоставить перевод на русский язык, "
+    "а также пример использования этого слова или словосочетания в предложении. "
+    "Ответ должен состоять из одной строки на каждое слово в том же порядке, без нумерации "
+    "и пояснений, а формат каждой строки должен строго соответствовать следующему шаблону:\n"
+    "\"<слово из запроса> | <русский вариант 1> ; <русский вариант 2> | "
+    "<Пример использования слова или словосочетания в предложении на английском языке>\"\n\n"
+    "Например\nслова:\n\"fine\ncat\"\nответ:\n"
+    "\"fine | хорошо ; отлично | I'm fine, thank you for asking.\n"
+    "cat | кот ; кошка | The cat is sleeping on the sofa.\"\n\n"
+    "Слово в начале строки должно быть в точности таким же, как в запросе. "
+    "Если запрашиваемого слова не существует, то строки для него быть не должно."};
+
+BulkTranslator::BulkTranslator(std::weak_ptr<HttpClient> client,
+                               std::vector<std::string> words, Options options)
+    : client_{std::move(client)}
+    , words_{std::move(words)}
+    , options_{options}
+{
+    options_.batch_size = std::max<size_t>(1, options_.batch_size);
+    options_.requests_in_flight = std::max<size_t>(1, options_.requests_in_flight);
+    batches_count_ = (words_.size() + options_.batch_size - 1) / options_.batch_size;
+
+    spdlog::info("{}(): {} words in {} batches, {} requests in flight", __FUNCTION__,
+                 words_.size(), batches_count_, options_.requests_in_flight);
+    send();
+    if (isFinished()) {
+        finished_ = std::chrono::steady_clock::now();
+    }
+}
+
+void BulkTranslator::poll(Handler const& handler)
+{
+    if (isFinished()) {
+        return;
+    }
+
+    std::vector<Response> responses;
+    {
+        std::lock_guard lock{inbox_->mutex};
+        responses.swap(inbox_->responses);
+    }
+    for (auto const& response : responses) {
+        --in_flight_;
+        handle(response, handler);
+    }
+    send();
+
+    if (isFinished()) {
+        finished_ = std::chrono::steady_clock::now();
+        auto const stat{progress()};
+        spdlog::info("bulk translation finished: {} of {} words translated, {} failed, "
+                     "{:.1f} s, {:.2f} words/s",
+                     stat.translated, stat.total, stat.failed,
+                     std::chrono::duration<double>(finished_ - started_).count(),
+                     stat.words_per_second);
+    }
+}
+
+BulkTranslator::Progress BulkTranslator::progress() const
+{
+    auto const end{isFinished() ? finished_ : std::chrono::steady_clock::now()};
+    auto const seconds{std::chrono::duration<double>(end - started_).count()};
+    return {
+        .total = words_.size(),
+        .translated = translated_,
+        .failed = failed_,
+        .words_per_second = seconds > 0 ? static_cast<double>(translated_) / seconds : 0.0,
+    };
+}
+
+std::string BulkTranslator::makeMessage(std::span<std::string const> words)
+{
+    std::string message;
+    for (auto const& word : words) {
+        message += word;
+        message += '\n';
+    }
+    return message;
+}
+
+std::vector<std::pair<size_t, vocabulary::Translation>> BulkTranslator::parseResponse(
+    std::string_view content, std::span<std::string const> words)
+{
+    using namespace tools::string_utils;
+
+    std::unordered_map<std::string, size_t> indices;
+    for (size_t i{0}; i < words.size(); ++i) {
+        indices.emplace(normalized(words[i]), i);
+    }
+
+    std::vector<std::pair<size_t, vocabulary::Translation>> result;
+    forEachToken(content, '\n', [&indices, &result](std::string_view line) {
+        // models like to quote the lines and to wrap the answer into a code block
+        line = trimmed(line);
+        while (!line.empty() && (line.front() == '"' || line.front() == '`')) {
+            line.remove_prefix(1);
+        }
+        while (!line.empty() && (line.back() == '"' || line.back() == '`' ||
+                                 line.back() == '\r')) {
+            line.remove_suffix(1);
+        }
+
+        auto const end{line.find(vocabulary::Translation::kDefaultFieldsDelimiter)};
+        if (end == std::string_view::npos) {
+            return;
+        }
+        auto const it{indices.find(normalized(line.substr(0, end)))};
+        if (it == indices.end()) {
+            return;
+        }
+        try {
+            result.emplace_back(it->second, vocabulary::Translation::parse(line.substr(end)));
+            indices.erase(it);  // the first translation of a word wins
+        } catch (std::exception const& ex) {
+            spdlog::debug("{}(): line \'{}\' is skipped: {}", __FUNCTION__, line, ex.what());
+        }
+    });
+    return result;
+}
+
+// private ================================================
+
+std::span<std::string const> BulkTranslator::batch(size_t index) const
+{
+    auto const first{index * options_.batch_size};
+    return std::span{words_}.subspan(first, std::min(options_.batch_size,
+                                                     words_.size() - first));
+}
+
+void BulkTranslator::send()
+{
+    auto const client{client_.lock()};
+    while (in_flight_ < options_.requests_in_flight && next_batch_ < batches_count_) {
+        auto const index{next_batch_++};
+        if (!client) {
+            spdlog::error("{}(): HTTP client is not available, batch #{} is dropped",
+                          __FUNCTION__, index);
+            failed_ += batch(index).size();
+            continue;
+        }
+
+        auto request{chat_completion::makeRequest(
+            kPrompt, makeMessage(batch(index)),
+            [inbox = inbox_, index](std::string const& response, std::string const& error) {
+                std::lock_guard lock{inbox->mutex};
+                inbox->responses.push_back({index, response, error});
+            })};
+        client->sendRequest(std::move(request));
+        ++in_flight_;
+    }
+}
+
+void BulkTranslator::handle(Response const& response, Handler const& handler)
+{
+    auto const words{batch(response.batch)};
+    if (!response.error.empty()) {
+        spdlog::error("{}(): batch #{} failed: {}", __FUNCTION__, response.batch,
+                      response.error);
+        failed_ += words.size();
+        return;
+    }
+
+    std::vector<std::pair<size_t, vocabulary::Translation>> translations;
+    try {
+        translations = parseResponse(chat_completion::content(response.body), words);
+    } catch (std::exception const& ex) {
+        spdlog::error("{}(): response to batch #{} can not be processed: {}", __FUNCTION__,
+                      response.batch, ex.what());
+        failed_ += words.size();
+        return;
+    }
+
+    for (auto& [index, translation] : translations) {
+        try {
+            handler(words[index], std::move(translation));
+            ++translated_;
+        } catch (std::exception const& ex) {
+            spdlog::error("{}(): translation of \'{}\' is not applied: {}", __FUNCTION__,
+                          words[index], ex.what());
+            ++failed_;
+        }
+    }
+    if (auto const missing{words.size() - translations.size()}; missing > 0) {
+        spdlog::warn("{}(): {} words of batch #{} are not translated", __FUNCTION__, missing,
+                     response.batch);
+        failed_ += missing;
+    }
+}
+
+}  // namespace network
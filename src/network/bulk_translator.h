@@ -0,0 +1,109 @@
+#ifndef NETWORK_BULK_TRANSLATOR_H
+#define NETWORK_BULK_TRANSLATOR_H
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "vocabulary/translation.h"
+
+namespace network {
+
+class HttpClient;
+
+/**
+ * Translates a list of words (e.g. the untranslated lines of an imported word list) with
+ * the chat completion server. The words are packed into batches, every batch is one
+ * request built by chat_completion::makeRequest(), and up to `requests_in_flight` batches
+ * are requested at once. Every response line "<word> | <variants> | <example>" is matched
+ * to a word of its batch and parsed with vocabulary::Translation::parse().
+ * The responses are queued by the client thread, so all the methods have to be called
+ * from the same (UI) thread.
+ */
+class BulkTranslator final {
+public:
+    struct Options {
+        size_t batch_size{20};
+        size_t requests_in_flight{4};
+    };
+
+    struct Progress {
+        size_t total{};
+        size_t translated{};
+        size_t failed{};  // skipped by the server, unparsable or lost with a failed request
+        double words_per_second{};
+    };
+
+    using Handler =
+        std::function<void(std::string const& word, vocabulary::Translation&& translation)>;
+
+    // system prompt of the batches, its hash is a part of the translation cache key
+    static std::string_view const kPrompt;
+
+    /**
+     * Sends the first batches right away
+     */
+    BulkTranslator(std::weak_ptr<HttpClient> client, std::vector<std::string> words,
+                   Options options);
+    BulkTranslator(BulkTranslator const& other) = delete;
+    BulkTranslator& operator=(BulkTranslator const& other) = delete;
+
+    /**
+     * Hands the received translations over to the handler and sends the next batches.
+     * A translation the handler throws for is counted as failed.
+     */
+    void poll(Handler const& handler);
+
+    bool isFinished() const { return in_flight_ == 0 && next_batch_ == batches_count_; }
+    Progress progress() const;
+
+    // user message of the batch: one word per line
+    static std::string makeMessage(std::span<std::string const> words);
+
+    /**
+     * @return indices of the batch words with their translations; the lines which don't
+     * start with a word of the batch or can not be parsed are skipped
+     */
+    static std::vector<std::pair<size_t, vocabulary::Translation>> parseResponse(
+        std::string_view content, std::span<std::string const> words);
+
+private:
+    struct Response {
+        size_t batch{};
+        std::string body;
+        std::string error;
+    };
+
+    // shared with the callbacks of the requests, so they never outlive it
+    struct Inbox {
+        std::mutex mutex;
+        std::vector<Response> responses;
+    };
+
+    std::weak_ptr<HttpClient> client_;
+    std::vector<std::string> words_;
+    Options options_;
+    std::shared_ptr<Inbox> inbox_{std::make_shared<Inbox>()};
+
+    size_t batches_count_{0};
+    size_t next_batch_{0};
+    size_t in_flight_{0};
+    size_t translated_{0};
+    size_t failed_{0};
+    std::chrono::steady_clock::time_point started_{std::chrono::steady_clock::now()};
+    std::chrono::steady_clock::time_point finished_{};
+
+    std::span<std::string const> batch(size_t index) const;
+    void send();
+    void handle(Response const& response, Handler const& handler);
+};
+
+}  // namespace network
+
+#endif  // NETWORK_BULK_TRANSLATOR_H
@@ -0,0 +1,94 @@
+#include "network/chat_completion.h"
+
+#include "common/config/config.h"
+#include "network/http/sse_parser.h"
+#include "nlohmann/json.hpp"
+#include "spdlog/spdlog.h"
+
+namespace {
+
+// the stream is finished by this event
+constexpr std::string_view kStreamEnd{"[DONE]"};
+
+// text of the first choice of a streamed chunk, empty for the role or the finish reason
+std::string deltaContent(std::string_view event)
+{
+    auto const json = nlohmann::json::parse(event);
+    auto const& delta{json.at("choices").at(0).at("delta")};
+    if (auto const it{delta.find("content")}; it != delta.end() && it->is_string()) {
+        return it->get<std::string>();
+    }
+    return {};
+}
+
+}  // namespace
+
+namespace network::chat_completion {
+
+std::shared_ptr<Request> makeRequest(std::string_view system_prompt,
+                                     std::string const& message, Request::Callback callback,
+                                     DeltaCallback on_delta)
+{
+    using enum common::ConfigId;
+    auto const& config{common::Config::instance()};
+
+    nlohmann::json body;
+    if (auto const model{config.getValue<std::string>(kTranslationModel)}; !model.empty()) {
+        body["model"] = model;
+    }
+    body["messages"] = nlohmann::json::array();
+    body["messages"].push_back({{"role", "system"}, {"content", std::string{system_prompt}}});
+    body["messages"].push_back({{"role", "user"}, {"content", message}});
+    body["temperature"] = 0.2;
+    body["stream"] = static_cast<bool>(on_delta);
+
+    auto request = std::make_shared<Request>();
+    request->host = config.getValue<std::string>(kDefaultServer);
+    request->port = config.getValue<std::string>(kDefaultPort);
+    request->target = config.getValue<std::string>(kDefaultTarget);
+    request->method = config.getValue<std::string>(kDefaultMethod);
+    request->headers = kHeaders;
+    // a completion has no side effects, so it's sent again if it fails
+    request->idempotent = true;
+    request->body = body.dump();
+    request->callback = std::move(callback);
+    if (on_delta) {
+        request->partial_callback = [on_delta = std::move(on_delta)](std::string_view event) {
+            if (event == kStreamEnd) {
+                return;
+            }
+            try {
+                if (auto const delta{deltaContent(event)}; !delta.empty()) {
+                    on_delta(delta);
+                }
+            } catch (std::exception const& ex) {
+                spdlog::warn("{}(): event \'{}\' is skipped: {}", __FUNCTION__, event, ex.what());
+            }
+        };
+    }
+
+    return request;
+}
+
+std::string content(std::string const& response)
+{
+    // the whole event stream of a streamed completion, a json object otherwise
+    if (auto const start{response.find_first_not_of(" \t\r\n")};
+        start != std::string::npos && response[start] != '{') {
+        std::string text;
+        SseParser parser;
+        auto const append = [&text](std::string_view event) {
+            if (event != kStreamEnd) {
+                text += deltaContent(event);
+            }
+        };
+        parser.feed(response, append);
+        parser.finish(append);
+        return text;
+    }
+
+    auto const json = nlohmann::json::parse(response);  // braces would make an array
+    return json.at("choices").at(0).at("message").at("content").get<std::string>();
+}
+
+}  // namespace network::chat_completion
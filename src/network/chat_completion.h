@@ -0,0 +1,41 @@
+#ifndef NETWORK_CHAT_COMPLETION_H
+#define NETWORK_CHAT_COMPLETION_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "network/http/request.h"
+
+namespace network::chat_completion {
+
+inline const std::vector<std::pair<std::string, std::string>> kHeaders{
+    {{"Content-Type", "application/json"}}};
+
+// text generated since the previous delta of a streamed completion
+using DeltaCallback = std::function<void(std::string_view delta)>;
+
+/**
+ * Request to the OpenAI-compatible chat completion endpoint of the translation server
+ * (kDefaultServer, kDefaultPort, kDefaultTarget, kDefaultMethod). The model is requested
+ * only if kTranslationModel is set.
+ * @param on_delta if set, the completion is streamed ("stream": true) and every piece of
+ * the text is passed to it as soon as it arrives
+ */
+std::shared_ptr<Request> makeRequest(std::string_view system_prompt,
+                                     std::string const& message, Request::Callback callback,
+                                     DeltaCallback on_delta = {});
+
+/**
+ * @return text of the first choice of the chat completion response, the deltas of
+ * a streamed response are joined
+ * @throw std::exception if the response is not a chat completion
+ */
+std::string content(std::string const& response);
+
+}  // namespace network::chat_completion
+
+#endif  // NETWORK_CHAT_COMPLETION_H
@@ -0,0 +1,133 @@
+#include "network/http/chunked_decoder.h"
+
+#include <algorithm>
+
+#include "spdlog/spdlog.h"
+
+namespace {
+
+int hexDigit(char ch)
+{
+    if (ch >= '0' && ch <= '9') {
+        return ch - '0';
+    }
+    if (ch >= 'a' && ch <= 'f') {
+        return ch - 'a' + 10;
+    }
+    if (ch >= 'A' && ch <= 'F') {
+        return ch - 'A' + 10;
+    }
+    return -1;
+}
+
+}  // namespace
+
+namespace network {
+
+size_t ChunkedDecoder::feed(std::string_view data)
+{
+    size_t pos{0};
+    while (pos < data.size() && state_ != State::kDone && state_ != State::kError) {
+        if (state_ == State::kData) {
+            // the data is copied at once, the rest of the states go byte by byte
+            auto const size{static_cast<size_t>(
+                std::min<uint64_t>(chunk_size_, data.size() - pos))};
+            body_.append(data.substr(pos, size));
+            pos += size;
+            chunk_size_ -= size;
+            if (chunk_size_ == 0) {
+                state_ = State::kDataEnd;
+            }
+            continue;
+        }
+
+        auto const ch{data[pos++]};
+        if (carriage_return_) {
+            carriage_return_ = false;
+            if (ch == '\n') {
+                endOfLine();
+            } else {
+                fail("CR is not followed by LF");
+            }
+            continue;
+        }
+        if (ch == '\r') {
+            carriage_return_ = true;
+            continue;
+        }
+        if (ch == '\n') {
+            fail("line ends with LF without CR");
+            continue;
+        }
+
+        switch (state_) {
+        case State::kSize:
+            if (auto const digit{hexDigit(ch)}; digit >= 0) {
+                chunk_size_ = chunk_size_ * 16 + static_cast<uint64_t>(digit);
+                size_has_digits_ = true;
+                if (chunk_size_ > kMaxChunkSize) {
+                    fail("chunk size is too big");
+                }
+            } else if (ch == ';' || ch == ' ' || ch == '\t') {
+                state_ = State::kExtension;
+            } else {
+                fail(fmt::format("unexpected character \'{}\' in the chunk size", ch));
+            }
+            break;
+        case State::kDataEnd:
+            // only CRLF may follow the data
+            fail("chunk data is longer than its size");
+            break;
+        case State::kTrailer:
+            trailer_line_empty_ = false;
+            break;
+        default:
+            break;
+        }
+    }
+    return pos;
+}
+
+// private ================================================
+
+void ChunkedDecoder::fail(std::string message)
+{
+    spdlog::error("{}(): {}", __FUNCTION__, message);
+    error_ = std::move(message);
+    state_ = State::kError;
+}
+
+// CRLF of the line has been read
+void ChunkedDecoder::endOfLine()
+{
+    switch (state_) {
+    case State::kSize:
+    case State::kExtension:
+        endOfSizeLine();
+        break;
+    case State::kDataEnd:
+        state_ = State::kSize;
+        break;
+    case State::kTrailer:
+        if (trailer_line_empty_) {
+            state_ = State::kDone;
+        }
+        trailer_line_empty_ = true;
+        break;
+    default:
+        break;
+    }
+}
+
+void ChunkedDecoder::endOfSizeLine()
+{
+    if (!size_has_digits_) {
+        fail("chunk size is missing");
+        return;
+    }
+    // the last chunk has zero size and is followed by the trailer
+    state_ = chunk_size_ == 0 ? State::kTrailer : State::kData;
+    size_has_digits_ = false;
+}
+
+}  // namespace network
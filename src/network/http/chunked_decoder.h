@@ -0,0 +1,62 @@
+#ifndef NETWORK_HTTP_CHUNKED_DECODER_H
+#define NETWORK_HTTP_CHUNKED_DECODER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace network {
+
+/**
+ * Incremental decoder of the "Transfer-Encoding: chunked" body. The body can be fed in
+ * parts of any size (as async_read_some() returns them), the decoder keeps its state
+ * between the parts, so the reads never block and never wait for a whole chunk.
+ * Chunk extensions and trailer fields are skipped. Every line has to end with CRLF and the
+ * chunk data has to be followed by CRLF, otherwise the body is malformed.
+ */
+class ChunkedDecoder final {
+public:
+    // a chunk bigger than this is treated as a malformed size line
+    static constexpr uint64_t kMaxChunkSize{uint64_t{1} << 32};
+
+    /**
+     * Decodes the next part of the body
+     * @return amount of consumed bytes, it's less than data.size() only if the body ends
+     * inside the data or the data is malformed
+     */
+    size_t feed(std::string_view data);
+
+    bool done() const { return state_ == State::kDone; }
+    bool failed() const { return state_ == State::kError; }
+    std::string const& error() const { return error_; }
+
+    std::string const& body() const { return body_; }
+    std::string release() { return std::move(body_); }
+
+private:
+    enum class State {
+        kSize,       // hex digits of the chunk size
+        kExtension,  // "; name=value" after the size, up to the end of the line
+        kData,
+        kDataEnd,    // CRLF after the chunk data
+        kTrailer,    // trailer fields after the last chunk, up to an empty line
+        kDone,
+        kError,
+    };
+
+    State state_{State::kSize};
+    uint64_t chunk_size_{0};
+    bool size_has_digits_{false};
+    bool trailer_line_empty_{true};
+    bool carriage_return_{false};  // the line ends, LF has to follow
+    std::string body_;
+    std::string error_;
+
+    void fail(std::string message);
+    void endOfLine();
+    void endOfSizeLine();
+};
+
+}  // namespace network
+
+#endif  // NETWORK_HTTP_CHUNKED_DECODER_H
@@ -0,0 +1,182 @@
+#include "network/http/client/connection_pool.h"
+
+#include <algorithm>
+
+#include "spdlog/spdlog.h"
+
+namespace network {
+
+ConnectionPool::ConnectionPool(asio::io_context& io_context, size_t max_per_host,
+                               std::chrono::steady_clock::duration idle_timeout)
+    : io_context_{io_context}
+    , max_per_host_{std::max<size_t>(1, max_per_host)}
+    , idle_timeout_{idle_timeout}
+    , sweep_timer_{io_context}
+{
+}
+
+bool ConnectionPool::tryAcquire(Request& request)
+{
+    auto& host{hosts_[key(request)]};
+    closeExpired(host);
+
+    if (!host.idle.empty()) {
+        // the most recently used connection is the least likely to be closed by the server
+        auto socket{std::move(host.idle.back().socket)};
+        host.idle.pop_back();
+        if (!request.retried) {
+            reuse(request, std::move(socket));
+            return true;
+        }
+        // the retried request failed on an idle connection, so it gets a new one instead
+        asio::error_code ec;
+        socket->close(ec);
+        --host.connections;
+    }
+
+    if (host.connections < max_per_host_) {
+        open(request, host);
+        return true;
+    }
+    return false;
+}
+
+void ConnectionPool::wait(std::shared_ptr<Request> request, ReadyHandler on_ready)
+{
+    auto& host{hosts_[key(*request)]};
+    spdlog::debug("{}(): {} connections to \'{}\' are busy, the request waits", __FUNCTION__,
+                  host.connections, key(*request));
+    host.waiting.push_back({std::move(request), std::move(on_ready)});
+}
+
+bool ConnectionPool::stopWaiting(Request const& request)
+{
+    auto const host{hosts_.find(key(request))};
+    if (host == hosts_.end()) {
+        return false;
+    }
+    auto& waiting{host->second.waiting};
+    auto const it{std::ranges::find_if(
+        waiting, [&request](auto const& w) { return w.request.get() == &request; })};
+    if (it == waiting.end()) {
+        return false;
+    }
+    auto on_ready{std::move(it->on_ready)};
+    waiting.erase(it);
+    asio::post(io_context_, std::move(on_ready));
+    return true;
+}
+
+void ConnectionPool::release(Request& request, bool reusable)
+{
+    if (!request.socket) {
+        return;
+    }
+
+    auto& host{hosts_[key(request)]};
+    auto socket{std::move(request.socket)};
+    request.reused_connection = false;
+    closeExpired(host);
+
+    if (reusable && socket->is_open()) {
+        if (host.waiting.empty()) {
+            host.idle.push_back({std::move(socket), std::chrono::steady_clock::now()});
+            scheduleSweep();
+            return;
+        }
+        // a retried request gets a new connection instead, as in tryAcquire()
+        if (!host.waiting.front().request->retried) {
+            auto next{std::move(host.waiting.front())};
+            host.waiting.pop_front();
+            reuse(*next.request, std::move(socket));
+            asio::post(io_context_, std::move(next.on_ready));
+            return;
+        }
+    }
+
+    asio::error_code ec;
+    socket->close(ec);
+    --host.connections;
+    if (!host.waiting.empty()) {
+        auto next{std::move(host.waiting.front())};
+        host.waiting.pop_front();
+        open(*next.request, host);
+        asio::post(io_context_, std::move(next.on_ready));
+    }
+}
+
+// private ================================================
+
+std::string ConnectionPool::key(Request const& request)
+{
+    return request.host + ':' + (request.port.empty() ? "80" : request.port);
+}
+
+void ConnectionPool::closeExpired(Host& host)
+{
+    auto const now{std::chrono::steady_clock::now()};
+    auto const expired = [this, now](IdleConnection const& connection) {
+        return now - connection.since > idle_timeout_;
+    };
+    for (auto& connection : host.idle) {
+        if (expired(connection)) {
+            asio::error_code ec;
+            connection.socket->close(ec);
+            --host.connections;
+        }
+    }
+    std::erase_if(host.idle, expired);
+}
+
+void ConnectionPool::scheduleSweep()
+{
+    if (sweep_scheduled_) {
+        return;
+    }
+    sweep_scheduled_ = true;
+    // a connection is closed at most half of the timeout late
+    sweep_timer_.expires_after(idle_timeout_ / 2);
+    sweep_timer_.async_wait([this](asio::error_code const& ec) {
+        // the pool may be destroyed already
+        if (ec == asio::error::operation_aborted) {
+            return;
+        }
+        sweep_scheduled_ = false;
+        sweep();
+    });
+}
+
+void ConnectionPool::sweep()
+{
+    auto idle{false};
+    for (auto it{hosts_.begin()}; it != hosts_.end();) {
+        auto& host{it->second};
+        closeExpired(host);
+        idle = idle || !host.idle.empty();
+        if (host.connections == 0 && host.waiting.empty()) {
+            it = hosts_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (idle) {
+        scheduleSweep();
+    }
+}
+
+void ConnectionPool::open(Request& request, Host& host)
+{
+    ++host.connections;
+    ++opened_;
+    request.socket = std::make_unique<asio::ip::tcp::socket>(io_context_);
+    request.reused_connection = false;
+}
+
+void ConnectionPool::reuse(Request& request, std::unique_ptr<asio::ip::tcp::socket> socket)
+{
+    ++reused_;
+    request.socket = std::move(socket);
+    request.reused_connection = true;
+}
+
+}  // namespace network
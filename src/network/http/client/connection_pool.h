@@ -0,0 +1,107 @@
+#ifndef NETWORK_HTTP_CLIENT_CONNECTION_POOL_H
+#define NETWORK_HTTP_CLIENT_CONNECTION_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "network/http/request.h"
+
+#include "asio.hpp"
+
+namespace network {
+
+/**
+ * Keep-alive connections of HttpClient, grouped by host and port. Every request in flight
+ * has its own connection: an idle one if there is any, a new one if the host has less than
+ * `max_per_host` connections, otherwise the request waits for a connection to be released.
+ * Idle connections are closed after `idle_timeout`: they are checked when a connection of
+ * the host is taken or released, and by a sweep of all the hosts, which runs while there
+ * are idle connections, so the ones of the hosts which are not requested anymore are
+ * closed too.
+ * Not thread-safe, all the methods but statistic() are called on the io_context thread.
+ */
+class ConnectionPool final {
+public:
+    // called once a connection is released for the waiting request
+    using ReadyHandler = std::function<void()>;
+
+    struct Statistic {
+        size_t opened{};  // connections opened
+        size_t reused{};  // requests sent on an idle connection
+    };
+
+    ConnectionPool(asio::io_context& io_context, size_t max_per_host,
+                   std::chrono::steady_clock::duration idle_timeout);
+    ConnectionPool(ConnectionPool const& other) = delete;
+    ConnectionPool& operator=(ConnectionPool const& other) = delete;
+
+    /**
+     * Gives the request a connection at once if there is an idle one or the host has less
+     * than `max_per_host` connections. The socket is not open if it has to be connected,
+     * request.reused_connection is set if it's an idle keep-alive one; it's never an idle
+     * one if request.retried is set.
+     * @return false if all the connections to the host are busy, the request has to wait()
+     */
+    bool tryAcquire(Request& request);
+
+    // the request gets the next released connection of its host, see tryAcquire()
+    void wait(std::shared_ptr<Request> request, ReadyHandler on_ready);
+    /**
+     * Stops waiting of the (cancelled) request: its handler is posted at once, without
+     * a connection
+     * @return false if the request doesn't wait
+     */
+    bool stopWaiting(Request const& request);
+
+    /**
+     * Takes the connection of the finished request back and passes it to the next waiting
+     * request of the host. Connections which can not be reused are closed.
+     */
+    void release(Request& request, bool reusable);
+
+    Statistic statistic() const { return {opened_.load(), reused_.load()}; }
+
+private:
+    struct IdleConnection {
+        std::unique_ptr<asio::ip::tcp::socket> socket;
+        std::chrono::steady_clock::time_point since;
+    };
+
+    struct WaitingRequest {
+        std::shared_ptr<Request> request;
+        ReadyHandler on_ready;
+    };
+
+    struct Host {
+        size_t connections{};  // in use and idle
+        std::vector<IdleConnection> idle;
+        std::deque<WaitingRequest> waiting;
+    };
+
+    asio::io_context& io_context_;
+    size_t max_per_host_;
+    std::chrono::steady_clock::duration idle_timeout_;
+    std::map<std::string, Host> hosts_;
+    asio::steady_timer sweep_timer_;
+    bool sweep_scheduled_{false};
+    std::atomic<size_t> opened_{0};
+    std::atomic<size_t> reused_{0};
+
+    static std::string key(Request const& request);
+    void closeExpired(Host& host);
+    // arms the sweep timer, unless it's armed already
+    void scheduleSweep();
+    void sweep();
+    void open(Request& request, Host& host);
+    void reuse(Request& request, std::unique_ptr<asio::ip::tcp::socket> socket);
+};
+
+}  // namespace network
+
+#endif  // NETWORK_HTTP_CLIENT_CONNECTION_POOL_H
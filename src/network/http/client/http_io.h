@@ -0,0 +1,212 @@
+#ifndef NETWORK_HTTP_CLIENT_HTTP_IO_H
+#define NETWORK_HTTP_CLIENT_HTTP_IO_H
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "common/exceptions/network_error.h"
+#include "network/http/chunked_decoder.h"
+#include "network/http/request.h"
+#include "network/http/response.h"
+
+#include "asio.hpp"
+#include "spdlog/spdlog.h"
+
+#include "tools/string_utils.h"
+
+/**
+ * HTTP/1.1 messages over any asio stream (a TCP socket or an SSL stream), shared by
+ * HttpClient and HttpsClient. The functions use the buffers of the request; readBody()
+ * throws asio::system_error if the stream fails or NetworkError if the body is malformed.
+ * Reading the head is left to the clients: every nested coroutine is one more frame to
+ * allocate per request.
+ */
+namespace network::http_io {
+
+// max bytes read from the stream at once
+inline constexpr std::size_t kReadSize{16 * 1024};
+
+inline std::string_view buffered(asio::streambuf const& buffer)
+{
+    auto const data{buffer.data()};
+    return {static_cast<char const*>(data.data()), data.size()};
+}
+
+inline void streamEvents(Request& request, std::string_view bytes)
+{
+    if (request.event_stream) {
+        request.event_stream->feed(bytes, request.partial_callback);
+    }
+}
+
+// fills request.request_buffer, nothing follows the body, so the connection can be reused
+inline void serializeRequest(Request& request, bool keep_alive)
+{
+    // the buffers are left from the previous attempt if the request is retried
+    request.request_buffer.consume(request.request_buffer.size());
+    request.response_buffer.consume(request.response_buffer.size());
+
+    std::ostream request_stream{&request.request_buffer};
+    request_stream << request.method << " " << request.target << " HTTP/1.1\r\n";
+    request_stream << "Host: " << request.host << "\r\n";
+    for (auto const& header : request.headers) {
+        request_stream << header.first << ": " << header.second << "\r\n";
+    }
+    request_stream << (keep_alive ? "Connection: keep-alive\r\n" : "Connection: close\r\n");
+    if (!request.body.empty()) {
+        request_stream << "Content-Length: " << request.body.length() << "\r\n";
+        request_stream << "Content-Type: application/json\r\n";
+    }
+    request_stream << "\r\n" << request.body;
+}
+
+/**
+ * Parses the status line and the headers, which are the first `size` bytes of the response
+ * buffer (as async_read_until() "\r\n\r\n" returned). request.keep_alive tells whether the
+ * connection can be reused and request.event_stream is created for an event stream response.
+ * @throw NetworkError if the status line is malformed
+ */
+inline Response parseHead(Request& request, std::size_t size)
+{
+    auto head{buffered(request.response_buffer).substr(0, size - 2)};
+    auto const next_line = [&head]() {
+        auto const end{head.find("\r\n")};
+        auto const line{head.substr(0, end)};
+        head.remove_prefix(end == std::string_view::npos ? head.size() : end + 2);
+        return line;
+    };
+
+    // "HTTP/1.1 200 OK"
+    Response response;
+    auto status_line{next_line()};
+    auto const version{status_line.substr(0, status_line.find(' '))};
+    status_line.remove_prefix(std::min(status_line.size(), version.size() + 1));
+    auto const [end, ec] = std::from_chars(status_line.data(),
+                                           status_line.data() + status_line.size(),
+                                           response.status);
+    if (!version.starts_with("HTTP/") || ec != std::errc{}) {
+        throw NetworkError("Response message is empty or HTTP version starts not from \'HTTP\'");
+    }
+    status_line.remove_prefix(end - status_line.data());
+    response.status_message = status_line.starts_with(' ') ? status_line.substr(1) : status_line;
+
+    while (!head.empty()) {
+        auto const header{next_line()};
+        spdlog::debug("Response Header: {}", header);
+        auto const colon{header.find(':')};
+        if (colon == std::string_view::npos) {
+            continue;
+        }
+        auto value{header.substr(colon + 1)};
+        value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+        response.headers.emplace_back(header.substr(0, colon), value);
+    }
+    request.response_buffer.consume(size);
+
+    // HTTP/1.1 connections are persistent unless the server closes them
+    request.keep_alive =
+        version != "HTTP/1.0" &&
+        tools::string_utils::toLowerCase(std::string{response.header("Connection")}) != "close";
+    if (request.partial_callback &&
+        tools::string_utils::toLowerCase(std::string{response.header("Content-Type")})
+            .contains("text/event-stream")) {
+        request.event_stream = std::make_unique<SseParser>();
+    }
+    return response;
+}
+
+// RFC 9112 6.3: responses to HEAD and 1xx, 204 and 304 responses end with the head,
+// whatever Content-Length or Transfer-Encoding they have
+inline bool hasBody(Request const& request, Response const& response)
+{
+    return request.method != "HEAD" && response.status >= 200 && response.status != 204 &&
+           response.status != 304;
+}
+
+/**
+ * Reads the body of the response whose head has been parsed by parseHead(). Every part of
+ * the body is read with async_read_some(), so a slow response never blocks the io thread;
+ * request.last_read is updated after each part.
+ */
+template <typename Stream>
+asio::awaitable<void> readBody(Stream& stream, Request& request, Response& response)
+{
+    if (!hasBody(request, response)) {
+        co_return;
+    }
+
+    auto& buffer{request.response_buffer};
+    auto const content_length{response.header("Content-Length")};
+
+    if (tools::string_utils::toLowerCase(std::string{response.header("Transfer-Encoding")})
+            .contains("chunked")) {
+        ChunkedDecoder decoder;
+        for (;;) {
+            auto const decoded{decoder.body().size()};
+            buffer.consume(decoder.feed(buffered(buffer)));
+            streamEvents(request, std::string_view{decoder.body()}.substr(decoded));
+            if (decoder.failed()) {
+                throw NetworkError("Chunked body is malformed: " + decoder.error());
+            }
+            if (decoder.done()) {
+                break;
+            }
+            // eof is an error as well, the body has not been finished yet
+            auto const length{co_await stream.async_read_some(buffer.prepare(kReadSize),
+                                                              asio::use_awaitable)};
+            buffer.commit(length);
+            request.last_read = std::chrono::steady_clock::now();
+        }
+        response.body = decoder.release();
+    } else if (!content_length.empty()) {
+        std::size_t size{};
+        auto const [end, ec] = std::from_chars(
+            content_length.data(), content_length.data() + content_length.size(), size);
+        if (ec != std::errc{}) {
+            throw NetworkError(fmt::format("Content-Length \'{}\' is malformed", content_length));
+        }
+        while (buffer.size() < size) {
+            auto const length{co_await stream.async_read_some(
+                buffer.prepare(std::min(kReadSize, size - buffer.size())), asio::use_awaitable)};
+            buffer.commit(length);
+            request.last_read = std::chrono::steady_clock::now();
+        }
+        response.body = buffered(buffer).substr(0, size);
+        buffer.consume(size);
+        streamEvents(request, response.body);
+    } else {
+        // neither the length nor chunks, so the body ends with the connection
+        request.keep_alive = false;
+        asio::error_code ec;
+        while (!ec) {
+            auto const bytes{buffered(buffer)};
+            response.body.append(bytes);
+            streamEvents(request, bytes);
+            buffer.consume(bytes.size());
+            auto const length{co_await stream.async_read_some(
+                buffer.prepare(kReadSize), asio::redirect_error(asio::use_awaitable, ec))};
+            buffer.commit(length);
+            request.last_read = std::chrono::steady_clock::now();
+        }
+        if (ec != asio::error::eof) {
+            throw asio::system_error(ec);
+        }
+        response.body.append(buffered(buffer));
+        streamEvents(request, buffered(buffer));
+        buffer.consume(buffer.size());
+    }
+
+    if (request.event_stream) {
+        request.event_stream->finish(request.partial_callback);
+    }
+}
+
+} // namespace network::http_io
+
+#endif // NETWORK_HTTP_CLIENT_HTTP_IO_H
@@ -4,7 +4,10 @@
 #include "spdlog/spdlog.h"
 
 #include "tools/scoped_async_wrapper.h"
+#include "common/exceptions/network_error.h"
+#include "network/http/client/http_io.h"
 #include "network/http/request.h"
+#include "network/http/response.h"
 
 #include <iostream>
 #include <string>
@@ -19,9 +22,7 @@ using asio::ip::tcp;
 class HttpsClient {
 public:
     HttpsClient()
-        : resolver_{io_context_}
-        , ssl_context_{asio::ssl::context::tlsv13}
-        , socket_{io_context_, ssl_context_}
+        : ssl_context_{asio::ssl::context::tlsv13}
         , work_guard_{asio::make_work_guard(io_context_)}
     {
         try {
@@ -57,251 +58,71 @@ public:
         request->body = body.empty() ? std::string{""} : body.dump();
         request->callback = callback;
 
-        asio::post(io_context_, [this, request]() { doResolve(request); });
+        sendRequest(request);
     }
 
-private:
-    void doResolve(std::shared_ptr<Request> request) {
-        resolver_.async_resolve(request->host, "443",
-            [this, request](const asio::error_code& res_ec, tcp::resolver::results_type results) {
-                if (!res_ec) {
-                    asio::async_connect(socket_.lowest_layer(), results,
-                        [this, request](const asio::error_code& con_ec, const tcp::endpoint&) {
-                            if (!con_ec) {
-                                socket_.async_handshake(asio::ssl::stream_base::client,
-                                    [this, request](const asio::error_code& ec) { // also "const std::error_code" is okay
-                                        if (!ec) {
-                                            sendRequestData(request);
-                                        } else {
-                                            handleError(request, "Handshake failed", ec);
-                                        }
-                                    });
-                            } else {
-                                handleError(request, "Connect failed", con_ec);
-                            }
-                        });
-                } else {
-                    handleError(request, "Resolve failed", res_ec);
-                }
-            });
+    // callback adapter of fetch(), see HttpClient::sendRequest()
+    void sendRequest(std::shared_ptr<Request> request) {
+        asio::co_spawn(io_context_, fetchToCallback(request), asio::detached);
     }
 
-    void sendRequestData(std::shared_ptr<Request> request) {
-        std::ostream request_stream{&request->request_buffer};
-        request_stream << request->method << " " << request->target << " HTTP/1.1\r\n";
-        request_stream << "Host: " << request->host << "\r\n";
-        for (const auto& header : request->headers) {
-            request_stream << header.first << ": " << header.second << "\r\n";
-        }
-        if (!request->body.empty()) {
-            request_stream << "Content-Length: " << request->body.length() << "\r\n";
-            request_stream << "Content-Type: application/json\r\n";
-            request_stream << "Connection: close\r\n\r\n";
-            request_stream << request->body;
+    /**
+     * Sends the request on a new TLS connection, which is closed after the response.
+     * Has to run on executor().
+     * @throw NetworkError if the request fails
+     */
+    asio::awaitable<Response> fetch(std::shared_ptr<Request> request) {
+        char const* stage = "Resolve failed";
+        std::string error;
+        try {
+            tcp::resolver resolver{io_context_};
+            auto const endpoints =
+                co_await resolver.async_resolve(request->host, "443", asio::use_awaitable);
+            asio::ssl::stream<tcp::socket> stream{io_context_, ssl_context_};
+            stage = "Connect failed";
+            co_await asio::async_connect(stream.lowest_layer(), endpoints, asio::use_awaitable);
+            stage = "Handshake failed";
+            co_await stream.async_handshake(asio::ssl::stream_base::client, asio::use_awaitable);
+            stage = "Write failed";
+            http_io::serializeRequest(*request, false);
+            co_await asio::async_write(stream, request->request_buffer.data(), asio::use_awaitable);
+            stage = "Read headers failed";
+            auto const head_size = co_await asio::async_read_until(
+                stream, request->response_buffer, "\r\n\r\n", asio::use_awaitable);
+            auto response = http_io::parseHead(*request, head_size);
+            stage = "Read content failed";
+            co_await http_io::readBody(stream, *request, response);
+            co_return response;
+        } catch (std::exception const& ex) {
+            error = fmt::format("{}; {}", stage, ex.what());
         }
-        request_stream << "\r\n\r\n";
-
-        // std::stringstream ss;
-        // ss << request_stream.rdbuf();
-        // spdlog::trace("Request: \n{}", ss.str());
-        // request_stream.seekp(0);
-
-        asio::async_write(socket_, request->request_buffer.data(),
-            [this, request](const asio::error_code& ec, std::size_t /*length*/) {
-                if (!ec) {
-                    readResponseHeaders(request);
-                } else {
-                    handleError(request, "Write failed", ec);
-                }
-            });
-    }
-
-    void readResponseHeaders(std::shared_ptr<Request> request) {
-        asio::async_read_until(socket_, request->response_buffer, "\r\n",
-            [this, request](const asio::error_code& ec, std::size_t /*length*/) {
-                if (!ec) {
-                    std::istream response_stream(&request->response_buffer);
-                    std::string http_version;
-                    response_stream >> http_version;
-                    unsigned int status_code;
-                    response_stream >> status_code;
-                    std::string status_message;
-                    std::getline(response_stream, status_message);
-                    if (!response_stream || http_version.substr(0, 5) != "HTTP/") {
-                        handleError(request, "Response message is empty or HTTP version starts not from \'HTTP\'", {});
-                        return;
-                    }
-                    if (status_code != 200 ) {
-                        spdlog::error("HTTP status code: {}; status message: {}", status_code, status_message);
-                    }
-                    asio::async_read_until(socket_, request->response_buffer, "\r\n\r\n",
-                        [this, request](const asio::error_code& ec, std::size_t /*length*/) {
-                                std::istream response_stream(&request->response_buffer);
-                                // Read and log headers
-                                std::string header;
-                                std::size_t content_length = 0;
-                                bool chunked = false;
-                                while (std::getline(response_stream, header) && header != "\r") {
-                                    spdlog::debug("Response Header: {}", header);
-                                    if (auto pos = header.find("Content-Length:"); pos != std::string::npos) {
-                                        content_length = std::stoi(header.substr(pos + 16));
-                                    }
-                                    if (header.find("Transfer-Encoding: chunked") != std::string::npos) {
-                                        chunked = true;
-                                    }
-                                }
-                                // Continue reading response body
-                                readResponseBody(request, content_length, chunked);
-                            }
-                        );
-                } else {
-                    handleError(request, "Read headers failed", ec);
-                }
-            });
+        throw NetworkError(error);
     }
 
-    void readResponseBody(std::shared_ptr<Request> request, std::size_t content_length, bool chunked) {
-        if (chunked) {
-            try {
-                spdlog::trace("------------------------------- readResponseBody -------------------------------");
-
-                auto read_until_delim = [this, request](std::string const& delim = "\r\n") -> size_t {
-                    spdlog::trace("------------------------------- read_until_delim -------------------------------");
-                    int amount_of_bytes_in_chunk{0};
-
-                    asio::error_code ec;
-                    asio::read_until(socket_, request->response_buffer, delim, ec);
-                    if (ec) {
-                        spdlog::error("Read until char failed. Error: {}", ec.message());
-                        return amount_of_bytes_in_chunk;
-                    }
-
-                    std::istream response_stream(&request->response_buffer);
-
-                    std::string bytes_count_str;
-                    std::getline(response_stream, bytes_count_str);
-                    spdlog::trace("bytes_count_str: {}", bytes_count_str);
-
-                    if (!bytes_count_str.empty()) {
-                        try {
-                            amount_of_bytes_in_chunk = std::stoi(bytes_count_str, nullptr, 16);
-                        }
-                        catch (std::exception const& ex) {
-                            spdlog::error("Error while extracting amount of bytes in the chunk: {}", ex.what());
-                        }
-                    }
-                    spdlog::trace("amount_of_bytes_in_chunk: {}", amount_of_bytes_in_chunk);
-                    spdlog::trace("--------------------------------------------------------------");
-                    return amount_of_bytes_in_chunk;
-                };
-
-                auto read_n_bytes = [this, request](size_t n, size_t& read_bytes_left_out) -> std::string {
-                    spdlog::trace("------------------------------- read_n_bytes -------------------------------");
-                    asio::error_code ec;
-                    std::string buffer;
-
-                    spdlog::trace("n = {}", n);
-                    spdlog::trace("response buffer size = {}", request->response_buffer.size());
+    asio::io_context::executor_type executor() { return io_context_.get_executor(); }
 
-                    auto amount_of_bytes_to_read{0};
-                    if (request->response_buffer.size() < n) {
-                        amount_of_bytes_to_read = n - request->response_buffer.size();
-                    }
-                    spdlog::trace("amount_of_bytes_to_read: {}", amount_of_bytes_to_read);
-
-                    auto bytes_read = asio::read(socket_, request->response_buffer, asio::transfer_exactly(amount_of_bytes_to_read), ec);
-                    spdlog::trace("bytes_read: {}", bytes_read);
-
-                    if (!ec || ec == asio::error::eof) {
-                        std::istream response_stream(&request->response_buffer);
-                        std::string response_body((std::istreambuf_iterator<char>(response_stream)),
-                                                  std::istreambuf_iterator<char>());
-
-                        spdlog::trace("content: {}", response_body);
-                        spdlog::trace("--------------------------------------------------------------");
-                        if (n < response_body.size()) {
-                            read_bytes_left_out = 0;
-                        }
-                        read_bytes_left_out = n - response_body.size();
-                        return response_body;
-                    }
-
-                    spdlog::trace("--------------------------------------------------------------");
-                    spdlog::error("Read content failed {}", ec.message());
-
-                    return {};
-                };
-
-                std::string response_body{};
-                auto amount_of_bytes_in_chunk = read_until_delim();
-                while (amount_of_bytes_in_chunk) {
-                    // Original value ('amount_of_bytes_in_chunk') represents amount of "valuable" chars,
-                    // but we also have to count '\r' and '\n' chars, which represents end of the chunk,
-                    // so, next part of the response message (read by 'read_until_delim' method)
-                    // will start with chunk size
-                    response_body += read_n_bytes(amount_of_bytes_in_chunk + 2, amount_of_bytes_in_chunk);
-                    if (amount_of_bytes_in_chunk == 0) {
-                        amount_of_bytes_in_chunk = read_until_delim();
-                    }
-                }
-                spdlog::trace(" chunk is finished -------------------------------");
-
-                if (request->callback) {
-                    request->callback(response_body, "");
-                }
-            }
-            catch (asio::system_error const& ex) {
-                handleError(request, "ReadResponseBody() - exception while reading ", ex.code());
+private:
+    asio::awaitable<void> fetchToCallback(std::shared_ptr<Request> request) {
+        std::string body;
+        std::string error;
+        try {
+            auto response = co_await fetch(request);
+            if (response.status != 200) {
+                spdlog::error("HTTP status code: {}; status message: {}", response.status,
+                              response.status_message);
             }
+            body = std::move(response.body);
+        } catch (std::exception const& ex) {
+            error = ex.what();
         }
-        else if (content_length > 0) {
-            asio::async_read(socket_, request->response_buffer, asio::transfer_exactly(content_length - request->response_buffer.size()),
-                [this, request, content_length](const asio::error_code& ec, std::size_t /*length*/) {
-                    if (!ec || ec == asio::error::eof) {
-                        std::istream response_stream(&request->response_buffer);
-                        std::string response_body((std::istreambuf_iterator<char>(response_stream)),
-                                                  std::istreambuf_iterator<char>());
-                        if (request->callback) {
-                            request->callback(response_body, "");
-                        }
-                    } else {
-                        handleError(request, "Read content failed", ec);
-                    }
-                });
-        }
-        else {
-            // No Content-Length and not chunked: read until EOF
-            asio::async_read(socket_, request->response_buffer, asio::transfer_at_least(1),
-                [this, request](const asio::error_code& ec, std::size_t /*length*/) {
-                    if (!ec) {
-                        readResponseBody(request, 0, false); // Recursive call
-                    } else if (ec == asio::error::eof) {
-                        std::istream response_stream(&request->response_buffer);
-                        std::string response_body((std::istreambuf_iterator<char>(response_stream)),
-                                                  std::istreambuf_iterator<char>());
-                        if (request->callback) {
-                            request->callback(response_body, "");
-                        }
-                    } else {
-                        handleError(request, "Read content failed", ec);
-                    }
-                });
-        }
-    }
-
-    void handleError(std::shared_ptr<Request> request, const std::string& message, const asio::error_code& ec) {
         if (request->callback) {
-            request->callback("", message + "; " + ec.message());
+            request->callback(body, error);
         }
-        // Optionally, you can close the socket on error
-        // asio::post(io_context_, [this]() { socket_.lowest_layer().close(); });
     }
 
 private:
     asio::io_context io_context_{};
-    tcp::resolver resolver_;
     asio::ssl::context ssl_context_;
-    asio::ssl::stream<tcp::socket> socket_;
     asio::executor_work_guard<asio::io_context::executor_type> work_guard_;
     std::unique_ptr<tools::AsyncWrapper> io_thread_;
 };
@@ -1,12 +1,26 @@
 // #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
 #include <string>
 // #include <sstream>
 #include <functional>
+#include <exception>
+#include <random>
+#include <unordered_map>
+#include <vector>
 // #include <vector>
 // #include <memory>
 // #include <mutex>
 
+#include "common/config/config.h"
+#include "common/exceptions/network_error.h"
+#include "network/http/client/connection_pool.h"
+#include "network/http/client/http_io.h"
 #include "network/http/request.h"
+#include "network/http/request_handle.h"
+#include "network/http/response.h"
 
 #include "asio.hpp"
 #include "spdlog/spdlog.h"
@@ -20,20 +34,43 @@ class HttpClient {
 public:
     using Callback = std::function<void(const std::string&, const std::string&)>;
 
-    HttpClient() = default;
+    struct RequestStatistic {
+        size_t connect_timeouts{};
+        size_t read_timeouts{};
+        size_t retries{};  // sent again after a failure, with the backoff
+        size_t cancelled{};
+        size_t coalesced{};  // not sent, an identical request was in flight
+    };
+
+    HttpClient()
+        : pool_{io_context_,
+                static_cast<size_t>(common::Config::instance().getValue<int>(
+                    common::ConfigId::kHttpConnectionsPerHost)),
+                std::chrono::seconds{common::Config::instance().getValue<int>(
+                    common::ConfigId::kHttpKeepAliveTimeout)}}
+        , connect_timeout_{common::Config::instance().getValue<int>(
+              common::ConfigId::kHttpConnectTimeout)}
+        , read_timeout_{common::Config::instance().getValue<int>(
+              common::ConfigId::kHttpReadTimeout)}
+        , retry_count_{static_cast<unsigned int>(std::max(
+              0, common::Config::instance().getValue<int>(common::ConfigId::kHttpRetryCount)))}
+        , retry_backoff_{std::max(
+              0, common::Config::instance().getValue<int>(common::ConfigId::kHttpRetryBackoff))}
+    {
+    }
 
     ~HttpClient() {
         work_guard_.reset();
         io_context_.stop();
     }
 
-    void sendRequest(const std::string& host,
-                     const std::string& port,
-                     const std::string& target,
-                     const std::string& method,
-                     const std::vector<std::pair<std::string, std::string>>& headers,
-                     const nlohmann::json& body,
-                     Request::Callback callback)
+    RequestHandle sendRequest(const std::string& host,
+                              const std::string& port,
+                              const std::string& target,
+                              const std::string& method,
+                              const std::vector<std::pair<std::string, std::string>>& headers,
+                              const nlohmann::json& body,
+                              Request::Callback callback)
     {
         auto request = std::make_shared<Request>();
         request->host = host;
@@ -44,242 +81,364 @@ public:
         request->body = body.empty() ? std::string{""} : body.dump();
         request->callback = callback;
 
-        asio::post(io_context_, [this, request]() { processRequest(request); });
+        return sendRequest(request);
     }
 
-    void sendRequest(std::shared_ptr<network::Request> request) {
-        // auto req = std::make_shared<Request>(request);
-        asio::post(io_context_, [this, request]() { processRequest(request); });
+    /**
+     * Callback adapter of fetch(): the callback gets the body or the error message.
+     * An idempotent request which is identical to one in flight (method, host, port,
+     * target, headers and body) is not sent, its callback gets the response of that one.
+     * Its partial callback is not called, the events go to the first request only.
+     * A cancelled caller of such shared request gets the "Cancelled" error at once, but the
+     * request itself is cancelled only when all its callers are.
+     */
+    RequestHandle sendRequest(std::shared_ptr<network::Request> request) {
+        asio::co_spawn(io_context_, fetchToCallback(request), asio::detached);
+        return {request, [this](std::shared_ptr<Request> request) {
+                    asio::post(io_context_, [this, request]() { cancel(*request); });
+                }};
     }
 
-private:
-    void processRequest(std::shared_ptr<Request> request) {
-        resolver_.async_resolve(request->host, request->port.empty() ? "80" : request->port,
-            [this, request](asio::error_code const& res_ec, asio::ip::tcp::resolver::results_type const& results) {
-                if (!res_ec) {
-                    asio::async_connect(socket_, results,
-                        [this, request](const asio::error_code& con_ec, asio::ip::tcp::endpoint const&) {
-                            if (!con_ec) {
-                                sendRequestData(request);
-                            } else {
-                                handleError(request, "Connect failed", con_ec);
-                            }
-                        });
+    /**
+     * Sends the request on a pooled connection and reads the whole response; the event
+     * stream data is passed to request->partial_callback while the body arrives,
+     * request->callback is not called.
+     * Connecting takes up to kHttpConnectTimeout, the response may pause for up to
+     * kHttpReadTimeout. An idempotent request (see Request::idempotent) which fails or gets
+     * 429, 502, 503 or 504 is sent again up to kHttpRetryCount times after a jittered
+     * exponential delay (kHttpRetryBackoff, doubled for every retry).
+     * Has to run on executor() (asio::co_spawn(client.executor(), ...)), the connection
+     * pool is not thread-safe.
+     * @throw NetworkError if the request fails or is cancelled
+     */
+    asio::awaitable<Response> fetch(std::shared_ptr<Request> request) {
+        assert(io_context_.get_executor().running_in_this_thread());
+        if (!request->timer) {
+            request->timer = std::make_unique<asio::steady_timer>(io_context_);
+        }
+        bool const idempotent = request->idempotent || isIdempotent(request->method);
+        unsigned int failures = 0;
+        for (;;) {
+            if (!pool_.tryAcquire(*request)) {
+                // GCC 12 destroys the non-trivial temporaries of a co_await expression
+                // twice, so the initiation captures references and there are no such
+                // temporaries below
+                co_await asio::async_initiate<decltype(asio::use_awaitable), void()>(
+                    [this, &request](auto handler) {
+                        // the pool keeps std::function, which needs a copyable handler
+                        auto shared = std::make_shared<decltype(handler)>(std::move(handler));
+                        pool_.wait(request, [shared]() { (*shared)(); });
+                    },
+                    asio::use_awaitable);
+            }
+            if (request->cancelled) {
+                // the connection has not been used
+                pool_.release(*request, true);
+                throw NetworkError("Cancelled");
+            }
+            auto& socket = *request->socket;
+            request->event_stream.reset();
+
+            char const* stage = "Resolve failed";
+            bool connected = socket.is_open();
+            bool nothing_received = false;
+            bool retryable = false;  // the next attempt may succeed
+            std::string error;
+            try {
+                if (!connected) {
+                    startDeadline(request, connect_timeout_);
+                    std::string const port = request->port.empty() ? "80" : request->port;
+                    asio::ip::tcp::resolver resolver{io_context_};
+                    auto const endpoints =
+                        co_await resolver.async_resolve(request->host, port, asio::use_awaitable);
+                    if (request->timed_out || request->cancelled) {
+                        throw asio::system_error{asio::error::operation_aborted};
+                    }
+                    stage = "Connect failed";
+                    co_await asio::async_connect(socket, endpoints, asio::use_awaitable);
+                    connected = true;
+                    // small requests and responses follow each other on a kept
+                    // connection, Nagle's algorithm would delay every one of them
+                    asio::error_code ec;
+                    socket.set_option(asio::ip::tcp::no_delay{true}, ec);
+                }
+                startDeadline(request, read_timeout_);
+                stage = "Write failed";
+                nothing_received = true;
+                http_io::serializeRequest(*request, true);
+                co_await asio::async_write(socket, request->request_buffer.data(),
+                                           asio::use_awaitable);
+                stage = "Read headers failed";
+                auto const head_size = co_await asio::async_read_until(
+                    socket, request->response_buffer, "\r\n\r\n", asio::use_awaitable);
+                nothing_received = false;
+                auto response = http_io::parseHead(*request, head_size);
+                stage = "Read content failed";
+                co_await http_io::readBody(socket, *request, response);
+                stopDeadline(*request);
+
+                // the connection goes back to the pool before the caller resumes, so it
+                // may send the next request
+                pool_.release(*request, request->keep_alive);
+                if (!idempotent || failures >= retry_count_ || !isRetryable(response.status)) {
+                    co_return response;
+                }
+                error = fmt::format("HTTP status code: {}; status message: {}", response.status,
+                                    response.status_message);
+                retryable = true;
+            } catch (asio::system_error const& ex) {
+                if (request->timed_out && !request->cancelled) {
+                    ++(connected ? read_timeouts_ : connect_timeouts_);
+                    error = fmt::format("{}; timed out", stage);
                 } else {
-                    handleError(request, "Resolve failed", res_ec);
+                    error = fmt::format("{}; {}", stage, ex.what());
                 }
-            });
-    }
+                // the events passed to the partial callback can not be taken back
+                retryable = !request->event_stream;
+            } catch (std::exception const& ex) {
+                // the response is malformed, it would be the same once more
+                error = fmt::format("{}; {}", stage, ex.what());
+            }
+            stopDeadline(*request);
+
+            // The server may close a keep-alive connection while it's idle. Nothing of the
+            // response has been received in this case, so an idempotent request is sent once
+            // more on a new connection at once. Others may have reached the server before the
+            // connection was closed, so they are not sent twice.
+            bool const stale = idempotent && nothing_received &&
+                               request->response_buffer.size() == 0 &&
+                               !request->timed_out && request->reused_connection &&
+                               !request->retried;
+            pool_.release(*request, false);
+            if (request->cancelled) {
+                throw NetworkError("Cancelled");
+            }
+            if (stale) {
+                spdlog::debug("{}(): reused connection to \'{}\' failed ({}), retrying",
+                              __FUNCTION__, request->host, error);
+                request->retried = true;
+                continue;
+            }
+            if (!retryable || !idempotent || failures >= retry_count_) {
+                throw NetworkError(error);
+            }
 
-    void sendRequestData(std::shared_ptr<Request> request) {
-        std::ostream request_stream{&request->request_buffer};
-        request_stream << request->method << " " << request->target << " HTTP/1.1\r\n";
-        request_stream << "Host: " << request->host << "\r\n";
-        for (const auto& header : request->headers) {
-            request_stream << header.first << ": " << header.second << "\r\n";
-        }
-        if (!request->body.empty()) {
-            request_stream << "Content-Length: " << request->body.length() << "\r\n";
-            request_stream << "Content-Type: application/json\r\n";
-            request_stream << "Connection: close\r\n\r\n";
-            request_stream << request->body;
+            auto const delay = backoff(failures++);
+            ++retries_;
+            spdlog::warn("{}(): {}, retry {} of {} in {} ms", __FUNCTION__, error, failures,
+                         retry_count_, delay.count());
+            request->timer->expires_after(delay);
+            asio::error_code ec;
+            co_await request->timer->async_wait(asio::redirect_error(asio::use_awaitable, ec));
+            if (request->cancelled) {
+                throw NetworkError("Cancelled");
+            }
         }
-        request_stream << "\r\n\r\n";
+    }
 
-        // std::stringstream ss;
-        // ss << request_stream.rdbuf();
-        // spdlog::trace("Request: \n{}", ss.str());
-        // request_stream.seekp(0);
+    asio::io_context::executor_type executor() { return io_context_.get_executor(); }
 
-        asio::async_write(socket_, request->request_buffer.data(),
-            [this, request](const asio::error_code& ec, std::size_t /*length*/) {
-                if (!ec) {
-                    readResponseHeaders(request);
-                } else {
-                    handleError(request, "Write failed", ec);
-                }
-            });
+    ConnectionPool::Statistic connectionsStatistic() const { return pool_.statistic(); }
+
+    RequestStatistic requestsStatistic() const {
+        return {connect_timeouts_.load(), read_timeouts_.load(), retries_.load(),
+                cancelled_.load(), coalesced_.load()};
     }
 
-    void readResponseHeaders(std::shared_ptr<Request> request) {
-        asio::async_read_until(socket_, request->response_buffer, "\r\n",
-            [this, request](const asio::error_code& ec, std::size_t /*length*/) {
-                if (!ec) {
-                    std::istream response_stream(&request->response_buffer);
-                    std::string http_version;
-                    response_stream >> http_version;
-                    unsigned int status_code;
-                    response_stream >> status_code;
-                    std::string status_message;
-                    std::getline(response_stream, status_message);
-                    if (!response_stream || http_version.substr(0, 5) != "HTTP/") {
-                        handleError(request, "Response message is empty or HTTP version starts not from \'HTTP\'", {});
-                        return;
-                    }
-                    if (status_code != 200 ) {
-                        spdlog::error("HTTP status code: {}; status message: {}", status_code, status_message);
-                    }
-                    asio::async_read_until(socket_, request->response_buffer, "\r\n\r\n",
-                        [this, request](const asio::error_code& ec, std::size_t /*length*/) {
-                                std::istream response_stream(&request->response_buffer);
-                                // Read and log headers
-                                std::string header;
-                                std::size_t content_length = 0;
-                                bool chunked = false;
-                                while (std::getline(response_stream, header) && header != "\r") {
-                                    spdlog::debug("Response Header: {}", header);
-                                    if (auto pos = header.find("Content-Length:"); pos != std::string::npos) {
-                                        content_length = std::stoi(header.substr(pos + 16));
-                                    }
-                                    if (header.find("Transfer-Encoding: chunked") != std::string::npos) {
-                                        chunked = true;
-                                    }
-                                }
-                                // Continue reading response body
-                                readResponseBody(request, content_length, chunked);
-                            }
-                        );
-                } else {
-                    handleError(request, "Read headers failed", ec);
-                }
-            });
+private:
+    static bool isIdempotent(std::string_view method) {
+        return method == "GET" || method == "HEAD" || method == "PUT" || method == "DELETE" ||
+               method == "OPTIONS";
     }
 
-    void readResponseBody(std::shared_ptr<Request> request, std::size_t content_length, bool chunked) {
-        if (chunked) {
-            try {
-                spdlog::trace("------------------------------- readResponseBody -------------------------------");
+    // the server is overloaded or restarting, the request may succeed later
+    static bool isRetryable(unsigned int status) {
+        return status == 429 || status == 502 || status == 503 || status == 504;
+    }
 
-                auto read_until_delim = [this, request](std::string const& delim = "\r\n") -> size_t {
-                    spdlog::trace("------------------------------- read_until_delim -------------------------------");
-                    int amount_of_bytes_in_chunk{0};
+    // kHttpRetryBackoff * 2^failures, 50..100% of it, so the retries of the requests which
+    // failed at once are spread
+    std::chrono::milliseconds backoff(unsigned int failures) {
+        auto const max = retry_backoff_.count() << std::min(failures, 16u);
+        return std::chrono::milliseconds{
+            std::uniform_int_distribution<std::chrono::milliseconds::rep>{max / 2, max}(rng_)};
+    }
 
-                    asio::error_code ec;
-                    asio::read_until(socket_, request->response_buffer, delim, ec);
-                    if (ec) {
-                        spdlog::error("Read until char failed. Error: {}", ec.message());
-                        return amount_of_bytes_in_chunk;
-                    }
+    // Closes the connection if the stage takes longer than `timeout`. The time counts from
+    // request->last_read, which is moved by every part of the body, so a streamed response
+    // may take longer if it does not pause for `timeout`.
+    static void startDeadline(std::shared_ptr<Request> const& request,
+                              std::chrono::steady_clock::duration timeout) {
+        request->timed_out = false;
+        request->last_read = std::chrono::steady_clock::now();
+        request->timer->expires_after(timeout);
+        waitDeadline(request, timeout, ++request->deadline_id);
+    }
 
-                    std::istream response_stream(&request->response_buffer);
+    static void waitDeadline(std::shared_ptr<Request> const& request,
+                             std::chrono::steady_clock::duration timeout, unsigned int id) {
+        request->timer->async_wait([weak = std::weak_ptr{request}, timeout,
+                                    id](asio::error_code const& ec) {
+            auto request = weak.lock();
+            if (ec || !request || request->deadline_id != id) {
+                return;
+            }
+            if (auto const expiry = request->last_read + timeout;
+                expiry > std::chrono::steady_clock::now()) {
+                request->timer->expires_at(expiry);
+                waitDeadline(request, timeout, id);
+                return;
+            }
+            request->timed_out = true;
+            if (request->socket) {
+                asio::error_code ignored;
+                request->socket->close(ignored);
+            }
+        });
+    }
 
-                    std::string bytes_count_str;
-                    std::getline(response_stream, bytes_count_str);
-                    spdlog::trace("bytes_count_str: {}", bytes_count_str);
+    static void stopDeadline(Request& request) {
+        ++request.deadline_id;
+        request.timer->cancel();
+    }
 
-                    if (!bytes_count_str.empty()) {
-                        try {
-                            amount_of_bytes_in_chunk = std::stoi(bytes_count_str, nullptr, 16);
-                        }
-                        catch (std::exception const& ex) {
-                            spdlog::error("Error while extracting amount of bytes in the chunk: {}", ex.what());
-                        }
-                    }
-                    spdlog::trace("amount_of_bytes_in_chunk: {}", amount_of_bytes_in_chunk);
-                    spdlog::trace("--------------------------------------------------------------");
-                    return amount_of_bytes_in_chunk;
-                };
+    // on the io thread
+    void cancel(Request& request) {
+        if (request.cancelled || leaveFlight(request)) {
+            return;
+        }
+        ++cancelled_;
+        abort(request);
+    }
 
-                auto read_n_bytes = [this, request](size_t n, size_t& read_bytes_left_out) -> std::string {
-                    spdlog::trace("------------------------------- read_n_bytes -------------------------------");
-                    asio::error_code ec;
-                    std::string buffer;
+    // the operation in progress fails with operation_aborted
+    void abort(Request& request) {
+        request.cancelled = true;
+        if (request.timer) {
+            request.timer->cancel();
+        }
+        if (request.socket) {
+            asio::error_code ec;
+            request.socket->close(ec);
+        }
+        // a request which waits for a connection would wait until some other one is over
+        pool_.stopWaiting(request);
+    }
 
-                    spdlog::trace("n = {}", n);
-                    spdlog::trace("response buffer size = {}", request->response_buffer.size());
+    // requests in flight which identical requests wait for, see sendRequest()
+    struct Flight {
+        Request* request;  // the hash of the key may collide, so it's compared
+        std::vector<std::shared_ptr<Request>> joined;
+        // the caller of the first request has cancelled it, the response is read for the
+        // joined ones only
+        bool cancelled{false};
+    };
+
+    // empty if the request can not be shared
+    static std::string flightKey(Request const& request) {
+        if (!request.idempotent && !isIdempotent(request.method)) {
+            return {};
+        }
+        return fmt::format("{} {}:{}{} {:x}", request.method, request.host, request.port,
+                           request.target, std::hash<std::string>{}(request.body));
+    }
 
-                    auto amount_of_bytes_to_read{0};
-                    if (request->response_buffer.size() < n) {
-                        amount_of_bytes_to_read = n - request->response_buffer.size();
-                    }
-                    spdlog::trace("amount_of_bytes_to_read: {}", amount_of_bytes_to_read);
-
-                    auto bytes_read = asio::read(socket_, request->response_buffer, asio::transfer_exactly(amount_of_bytes_to_read), ec);
-                    spdlog::trace("bytes_read: {}", bytes_read);
-
-                    if (!ec || ec == asio::error::eof) {
-                        std::istream response_stream(&request->response_buffer);
-                        std::string response_body((std::istreambuf_iterator<char>(response_stream)),
-                                                  std::istreambuf_iterator<char>());
-
-                        spdlog::trace("content: {}", response_body);
-                        spdlog::trace("--------------------------------------------------------------");
-                        if (n < response_body.size()) {
-                            read_bytes_left_out = 0;
-                        }
-                        read_bytes_left_out = n - response_body.size();
-                        return response_body;
-                    }
+    static bool isSame(Request const& lhs, Request const& rhs) {
+        return lhs.method == rhs.method && lhs.host == rhs.host && lhs.port == rhs.port &&
+               lhs.target == rhs.target && lhs.headers == rhs.headers && lhs.body == rhs.body;
+    }
 
-                    spdlog::trace("--------------------------------------------------------------");
-                    spdlog::error("Read content failed {}", ec.message());
-
-                    return {};
-                };
-
-                std::string response_body{};
-                auto amount_of_bytes_in_chunk = read_until_delim();
-                while (amount_of_bytes_in_chunk) {
-                    // Original value ('amount_of_bytes_in_chunk') represents amount of "valuable" chars,
-                    // but we also have to count '\r' and '\n' chars, which represents end of the chunk,
-                    // so, next part of the response message (read by 'read_until_delim' method)
-                    // will start with chunk size
-                    response_body += read_n_bytes(amount_of_bytes_in_chunk + 2, amount_of_bytes_in_chunk);
-                    if (amount_of_bytes_in_chunk == 0) {
-                        amount_of_bytes_in_chunk = read_until_delim();
-                    }
-                }
-                spdlog::trace(" chunk is finished -------------------------------");
+    /**
+     * Takes the cancelled caller out of the shared request, its callback gets "Cancelled".
+     * The request goes on while any other caller waits for it, once there are none it's
+     * aborted.
+     * @return false if the request is not shared or nobody else waits for it, so it has to
+     * be aborted by the caller
+     */
+    bool leaveFlight(Request& request) {
+        auto const key = flightKey(request);
+        auto const it = key.empty() ? flights_.end() : flights_.find(key);
+        if (it == flights_.end()) {
+            return false;
+        }
+        auto& flight = it->second;
 
-                if (request->callback) {
-                    request->callback(response_body, "");
-                }
+        if (flight.request == &request) {
+            if (flight.cancelled) {
+                return true;
             }
-            catch (asio::system_error const& ex) {
-                handleError(request, "ReadResponseBody() - exception while reading ", ex.code());
+            if (flight.joined.empty()) {
+                return false;
             }
+            flight.cancelled = true;
+            ++cancelled_;
+            if (request.callback) {
+                request.callback("", "Cancelled");
+            }
+            return true;
         }
-        else if (content_length > 0) {
-            asio::async_read(socket_, request->response_buffer, asio::transfer_exactly(content_length - request->response_buffer.size()),
-                [this, request, content_length](const asio::error_code& ec, std::size_t /*length*/) {
-                    if (!ec || ec == asio::error::eof) {
-                        std::istream response_stream(&request->response_buffer);
-                        std::string response_body((std::istreambuf_iterator<char>(response_stream)),
-                                                  std::istreambuf_iterator<char>());
-                        if (request->callback) {
-                            request->callback(response_body, "");
-                        }
-                    } else {
-                        handleError(request, "Read content failed", ec);
-                    }
-                });
+
+        auto const joined = std::ranges::find_if(
+            flight.joined, [&request](auto const& other) { return other.get() == &request; });
+        if (joined == flight.joined.end()) {
+            return false;
         }
-        else {
-            // No Content-Length and not chunked: read until EOF
-            asio::async_read(socket_, request->response_buffer, asio::transfer_at_least(1),
-                [this, request](const asio::error_code& ec, std::size_t /*length*/) {
-                    if (!ec) {
-                        readResponseBody(request, 0, false); // Recursive call
-                    } else if (ec == asio::error::eof) {
-                        std::istream response_stream(&request->response_buffer);
-                        std::string response_body((std::istreambuf_iterator<char>(response_stream)),
-                                                  std::istreambuf_iterator<char>());
-                        if (request->callback) {
-                            request->callback(response_body, "");
-                        }
-                    } else {
-                        handleError(request, "Read content failed", ec);
-                    }
-                });
+        auto const other = std::move(*joined);
+        flight.joined.erase(joined);
+        other->cancelled = true;
+        ++cancelled_;
+        if (flight.cancelled && flight.joined.empty()) {
+            abort(*flight.request);
         }
+        // the flight is not used below, the callback may send the same request again
+        if (other->callback) {
+            other->callback("", "Cancelled");
+        }
+        return true;
     }
 
-    void handleError(std::shared_ptr<Request> request, const std::string& message, const asio::error_code& ec) {
-        if (request->callback) {
-            request->callback("", message + "; " + ec.message());
+    asio::awaitable<void> fetchToCallback(std::shared_ptr<Request> request) {
+        auto const key = flightKey(*request);
+        bool shared = false;  // identical requests may join this one
+        if (!key.empty()) {
+            auto const [flight, inserted] = flights_.try_emplace(key, Flight{request.get(), {}});
+            if (!inserted && isSame(*flight->second.request, *request)) {
+                spdlog::debug("{}(): {} joins the identical request in flight", __FUNCTION__,
+                              request->target);
+                ++coalesced_;
+                flight->second.joined.push_back(std::move(request));
+                co_return;
+            }
+            shared = inserted;
+        }
+
+        std::string body;
+        std::string error;
+        try {
+            auto response = co_await fetch(request);
+            if (response.status != 200) {
+                spdlog::error("HTTP status code: {}; status message: {}", response.status,
+                              response.status_message);
+            }
+            body = std::move(response.body);
+        } catch (std::exception const& ex) {
+            error = ex.what();
+        }
+
+        // the flight is over before the callbacks, which may send the same request again;
+        // the cancelled callers have already got "Cancelled" and left it
+        Flight flight{request.get(), {}};
+        if (shared) {
+            flight = std::move(flights_.extract(key).mapped());
+        }
+        if (request->callback && !flight.cancelled) {
+            request->callback(body, error);
+        }
+        for (auto const& other : flight.joined) {
+            if (other->callback) {
+                other->callback(body, error);
+            }
         }
-        // Optionally, you can close the socket on error
-        // asio::post(io_context_, [this]() { socket_.lowest_layer().close(); });
     }
 
 private:
@@ -288,8 +447,18 @@ private:
         // , work_guard_{asio::make_work_guard(io_context_)}
         // , io_thread_{std::make_unique<tools::AsyncWrapper>([this] { io_context_.run(); })}
     asio::io_context io_context_{};
-    asio::ip::tcp::resolver resolver_{io_context_};
-    asio::ip::tcp::socket socket_{io_context_};
+    ConnectionPool pool_;
+    std::chrono::seconds connect_timeout_;
+    std::chrono::seconds read_timeout_;
+    unsigned int retry_count_;
+    std::chrono::milliseconds retry_backoff_;
+    std::mt19937 rng_{std::random_device{}()};  // jitter of the retries, used on the io thread
+    std::atomic<size_t> connect_timeouts_{0};
+    std::atomic<size_t> read_timeouts_{0};
+    std::atomic<size_t> retries_{0};
+    std::atomic<size_t> cancelled_{0};
+    std::atomic<size_t> coalesced_{0};
+    std::unordered_map<std::string, Flight> flights_;  // used on the io thread
     asio::executor_work_guard<asio::io_context::executor_type> work_guard_{asio::make_work_guard(io_context_)};
     std::unique_ptr<tools::AsyncWrapper> io_thread_{std::make_unique<tools::AsyncWrapper>([this] { io_context_.run(); })};
     // std::mutex mutex_;
@@ -1,10 +1,15 @@
 #ifndef NETWORK_HTTP_REQUEST_H
 #define NETWORK_HTTP_REQUEST_H
 
+#include <chrono>
 #include <string>
 #include <vector>
 #include <utility>
 #include <functional>
+#include <memory>
+#include <string_view>
+
+#include "network/http/sse_parser.h"
 
 #include "asio.hpp"
 
@@ -12,6 +17,8 @@ namespace network {
 
 struct Request {
     using Callback = std::function<void(const std::string&, const std::string&)>;
+    // data of an event of a "text/event-stream" response
+    using PartialCallback = std::function<void(std::string_view)>;
 
     std::string host;
     std::string port;
@@ -20,8 +27,26 @@ struct Request {
     std::vector<std::pair<std::string, std::string>> headers;
     std::string body;
     Callback callback;
+    // called for every event of an event stream response as soon as it arrives, the
+    // callback still gets the whole body at the end
+    PartialCallback partial_callback;
     asio::streambuf request_buffer;
     asio::streambuf response_buffer;
+    // connection of the request, so several requests can be in flight at once
+    std::unique_ptr<asio::ip::tcp::socket> socket;
+    bool reused_connection{false};  // the socket is an idle keep-alive connection
+    bool retried{false};            // sent once more after the reused connection failed
+    bool keep_alive{false};         // the connection can be reused after the response
+    std::unique_ptr<SseParser> event_stream;  // set if the response is an event stream
+    // the request may be sent again after a failure; set it for a POST without side effects
+    // (a chat completion), GET, HEAD, PUT, DELETE and OPTIONS requests are idempotent anyway
+    bool idempotent{false};
+    // deadline of the request stage in progress and the delay before a retry
+    std::unique_ptr<asio::steady_timer> timer;
+    unsigned int deadline_id{0};  // a deadline which fires after its stage is over is ignored
+    std::chrono::steady_clock::time_point last_read;  // the read timeout counts from it
+    bool timed_out{false};
+    bool cancelled{false};
 };
 
 } // namespace network
@@ -0,0 +1,44 @@
+#ifndef NETWORK_HTTP_REQUEST_HANDLE_H
+#define NETWORK_HTTP_REQUEST_HANDLE_H
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "network/http/request.h"
+
+namespace network {
+
+/**
+ * Handle of a request sent by HttpClient::sendRequest(), which cancels it. The callback of
+ * a cancelled request gets the "Cancelled" error unless the response has been received.
+ * The handle has to be used while the client exists.
+ */
+class RequestHandle final {
+public:
+    using Cancel = std::function<void(std::shared_ptr<Request>)>;
+
+    RequestHandle() = default;
+    RequestHandle(std::weak_ptr<Request> request, Cancel cancel)
+        : request_{std::move(request)}
+        , cancel_{std::move(cancel)}
+    {}
+
+    // thread-safe, does nothing if the request is over
+    void cancel() const
+    {
+        if (auto request = request_.lock(); request && cancel_) {
+            cancel_(std::move(request));
+        }
+    }
+
+    bool expired() const { return request_.expired(); }
+
+private:
+    std::weak_ptr<Request> request_;
+    Cancel cancel_;
+};
+
+} // namespace network
+
+#endif // NETWORK_HTTP_REQUEST_HANDLE_H
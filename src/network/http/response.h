@@ -0,0 +1,36 @@
+#ifndef NETWORK_HTTP_RESPONSE_H
+#define NETWORK_HTTP_RESPONSE_H
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace network {
+
+struct Response {
+    unsigned int status{};
+    std::string status_message;
+    std::vector<std::pair<std::string, std::string>> headers;
+    // decoded body (chunked transfer encoding is removed)
+    std::string body;
+
+    // value of the first header with the name (case-insensitive), empty if there is none
+    std::string_view header(std::string_view name) const
+    {
+        auto const same = [name](auto const& header) {
+            return std::ranges::equal(header.first, name, [](char lhs, char rhs) {
+                return std::tolower(static_cast<unsigned char>(lhs)) ==
+                       std::tolower(static_cast<unsigned char>(rhs));
+            });
+        };
+        auto const it{std::ranges::find_if(headers, same)};
+        return it == headers.end() ? std::string_view{} : std::string_view{it->second};
+    }
+};
+
+} // namespace network
+
+#endif // NETWORK_HTTP_RESPONSE_H
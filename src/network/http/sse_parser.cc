@@ -0,0 +1,62 @@
+#include "network/http/sse_parser.h"
+
+namespace network {
+
+void SseParser::feed(std::string_view bytes, EventHandler const& handler)
+{
+    while (!bytes.empty()) {
+        auto const end{bytes.find('\n')};
+        line_.append(bytes.substr(0, end));
+        if (end == std::string_view::npos) {
+            break;  // the rest of the line comes with the next part
+        }
+        bytes.remove_prefix(end + 1);
+        processLine(handler);
+    }
+}
+
+void SseParser::finish(EventHandler const& handler)
+{
+    if (!line_.empty()) {
+        processLine(handler);
+    }
+    dispatch(handler);
+}
+
+// private ================================================
+
+void SseParser::processLine(EventHandler const& handler)
+{
+    std::string_view line{line_};
+    if (line.ends_with('\r')) {
+        line.remove_suffix(1);
+    }
+
+    // "field: value", "field" (empty value) or ": comment"
+    auto const colon{line.find(':')};
+    if (line.empty()) {
+        dispatch(handler);
+    } else if (line.substr(0, colon) == "data") {
+        auto value{colon == std::string_view::npos ? std::string_view{} : line.substr(colon + 1)};
+        if (value.starts_with(' ')) {
+            value.remove_prefix(1);
+        }
+        if (has_data_) {
+            data_ += '\n';
+        }
+        data_.append(value);
+        has_data_ = true;
+    }
+    line_.clear();
+}
+
+void SseParser::dispatch(EventHandler const& handler)
+{
+    if (has_data_ && handler) {
+        handler(data_);
+    }
+    data_.clear();
+    has_data_ = false;
+}
+
+}  // namespace network
@@ -0,0 +1,37 @@
+#ifndef NETWORK_HTTP_SSE_PARSER_H
+#define NETWORK_HTTP_SSE_PARSER_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace network {
+
+/**
+ * Incremental parser of "text/event-stream" bodies (server-sent events), which are used by
+ * the chat completion servers to stream the tokens ("stream": true). The body can be fed in
+ * parts of any size; the data of every complete event is passed to the handler.
+ * Lines end with LF or CRLF; "data" lines of an event are joined with LF; comments and the
+ * other fields ("event", "id", "retry") are skipped.
+ */
+class SseParser final {
+public:
+    using EventHandler = std::function<void(std::string_view data)>;
+
+    void feed(std::string_view bytes, EventHandler const& handler);
+
+    // dispatches the last event if the stream ends without an empty line after it
+    void finish(EventHandler const& handler);
+
+private:
+    std::string line_;
+    std::string data_;
+    bool has_data_{false};
+
+    void processLine(EventHandler const& handler);
+    void dispatch(EventHandler const& handler);
+};
+
+}  // namespace network
+
+#endif  // NETWORK_HTTP_SSE_PARSER_H
@@ -0,0 +1,367 @@
+#include "network/translation_cache.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "common/exceptions/global_error.h"
+#include "common/exceptions/parsing_error.h"
+#include "spdlog/spdlog.h"
+#include "tools/binary_stream.h"
+#include "tools/file_utils.h"
+#include "tools/string_utils.h"
+
+namespace {
+
+uint64_t hash64(std::string_view data)
+{
+    uint64_t hash{14695981039346656037ull};
+    for (auto const ch : data) {
+        hash ^= static_cast<uint8_t>(ch);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+}  // namespace
+
+namespace network {
+
+TranslationCache::Key TranslationCache::makeKey(std::string_view word, std::string_view model,
+                                                std::string_view prompt)
+{
+    return {tools::string_utils::normalized(word), std::string{model}, hash64(prompt)};
+}
+
+TranslationCache::TranslationCache(std::filesystem::path path, size_t memory_limit,
+                                   size_t file_limit)
+    : path_{std::move(path)}
+    , memory_limit_{memory_limit}
+    , file_limit_{file_limit}
+{
+    if (path_.empty()) {
+        return;
+    }
+
+    open();
+    try {
+        load();
+    } catch (...) {
+        close();
+        throw;
+    }
+    spdlog::info("translation cache \'{}\' opened, entries: {}", path_.string(), index_.size());
+}
+
+TranslationCache::~TranslationCache() { close(); }
+
+std::optional<std::string> TranslationCache::find(Key const& key)
+{
+    auto const serialized{serialize(key)};
+    std::lock_guard lock{mutex_};
+
+    if (auto const it{lru_index_.find(serialized)}; it != lru_index_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        ++hits_;
+        return it->second->second;
+    }
+
+    if (auto const it{index_.find(serialized)}; it != index_.end()) {
+        if (auto translation{read(it->second)}) {
+            remember(serialized, *translation);
+            ++hits_;
+            return translation;
+        }
+    }
+
+    ++misses_;
+    return std::nullopt;
+}
+
+void TranslationCache::insert(Key const& key, std::string_view translation)
+{
+    auto const serialized{serialize(key)};
+    std::lock_guard lock{mutex_};
+
+    if (fd_ >= 0 && append(serialized, translation)) {
+        if (file_size_ > file_limit_ || dead_size_ > file_size_ / 2) {
+            compact();
+        }
+    }
+    remember(serialized, std::string{translation});
+}
+
+TranslationCache::Statistic TranslationCache::statistic() const
+{
+    std::lock_guard lock{mutex_};
+    return {.hits = hits_,
+            .misses = misses_,
+            .entries = index_.size(),
+            .memory_entries = lru_.size(),
+            .memory_size = memory_size_,
+            .file_size = file_size_};
+}
+
+// private ================================================
+
+std::string TranslationCache::serialize(Key const& key)
+{
+    // the unit separator can't appear in a word or a model name
+    return fmt::format("{}\x1f{}\x1f{:016x}", key.word, key.model, key.prompt_hash);
+}
+
+void TranslationCache::open()
+{
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw GlobalError(fmt::format("{}(): failed to open \'{}\': {}", __FUNCTION__,
+                                      path_.string(), std::strerror(errno)));
+    }
+    struct stat st{};
+    if (::fstat(fd_, &st) != 0) {
+        auto const error{errno};
+        close();
+        throw GlobalError(fmt::format("{}(): failed to stat \'{}\': {}", __FUNCTION__,
+                                      path_.string(), std::strerror(error)));
+    }
+    file_size_ = static_cast<size_t>(st.st_size);
+}
+
+void TranslationCache::load()
+{
+    std::vector<uint8_t> data(file_size_);
+    for (size_t done{0}; done < data.size();) {
+        auto const read{::pread(fd_, data.data() + done, data.size() - done,
+                                static_cast<off_t>(done))};
+        if (read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (read <= 0) {
+            throw GlobalError(fmt::format("{}(): failed to read \'{}\'", __FUNCTION__,
+                                          path_.string()));
+        }
+        done += static_cast<size_t>(read);
+    }
+
+    if (data.size() < kHeaderSize) {
+        // new file or a crash while the header was written
+        tools::binary::Writer header{kHeaderSize};
+        header.writeBytes({reinterpret_cast<uint8_t const*>(kMagic.data()), kMagic.size()});
+        header.writeU16(kVersion);
+        if (::ftruncate(fd_, 0) != 0 ||
+            ::write(fd_, header.data().data(), header.data().size()) !=
+                static_cast<ssize_t>(header.data().size())) {
+            throw GlobalError(fmt::format("{}(): failed to write \'{}\': {}", __FUNCTION__,
+                                          path_.string(), std::strerror(errno)));
+        }
+        file_size_ = kHeaderSize;
+        return;
+    }
+
+    tools::binary::Reader header{data};
+    auto const magic{header.readBytes(kMagic.size())};
+    if (!std::equal(magic.begin(), magic.end(), kMagic.begin()) ||
+        header.readU16() != kVersion) {
+        throw GlobalError(fmt::format("{}(): \'{}\' is not a translation cache", __FUNCTION__,
+                                      path_.string()));
+    }
+
+    auto offset{kHeaderSize};
+    while (offset < data.size()) {
+        auto const payload{tools::binary::readRecord(std::span{data}.subspan(offset))};
+        if (!payload) {
+            break;
+        }
+        auto const record_size{tools::binary::kRecordHeaderSize + payload->size()};
+
+        tools::binary::Reader record{*payload};
+        std::string key;
+        std::string_view translation;
+        try {
+            key = record.readString();
+            translation = record.readString();
+        } catch (ParsingError const&) {
+            break;
+        }
+        auto const location{Location{
+            .offset = static_cast<size_t>(
+                reinterpret_cast<uint8_t const*>(translation.data()) - data.data()),
+            .size = translation.size(),
+            .record_size = record_size}};
+        if (auto const [it, inserted] = index_.try_emplace(std::move(key), location);
+            !inserted) {
+            dead_size_ += it->second.record_size;
+            it->second = location;
+        }
+        offset += record_size;
+    }
+
+    if (offset < data.size()) {
+        spdlog::warn("{}(): torn tail of the translation cache \'{}\' ({} bytes) is cut off",
+                     __FUNCTION__, path_.string(), data.size() - offset);
+        if (::ftruncate(fd_, static_cast<off_t>(offset)) != 0) {
+            throw GlobalError(fmt::format("{}(): failed to truncate \'{}\': {}", __FUNCTION__,
+                                          path_.string(), std::strerror(errno)));
+        }
+        file_size_ = offset;
+    }
+}
+
+void TranslationCache::close()
+{
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool TranslationCache::append(std::string const& key, std::string_view translation)
+{
+    tools::binary::Writer payload{key.size() + translation.size() + 8};
+    payload.writeString(key);
+    payload.writeString(translation);
+
+    tools::binary::Writer record{tools::binary::kRecordHeaderSize + payload.data().size()};
+    tools::binary::writeRecord(record, payload.data());
+
+    auto const& bytes{record.data()};
+    ssize_t written{};
+    do {
+        written = ::write(fd_, bytes.data(), bytes.size());
+    } while (written < 0 && errno == EINTR);
+    if (written != static_cast<ssize_t>(bytes.size())) {
+        // a short write leaves a torn record, which is cut off on the next open
+        spdlog::error("{}(): failed to write \'{}\', the file is not used anymore: {}",
+                      __FUNCTION__, path_.string(), std::strerror(errno));
+        close();
+        return false;
+    }
+
+    auto const location{Location{.offset = file_size_ + bytes.size() - translation.size(),
+                                 .size = translation.size(),
+                                 .record_size = bytes.size()}};
+    if (auto const [it, inserted] = index_.try_emplace(key, location); !inserted) {
+        dead_size_ += it->second.record_size;
+        it->second = location;
+    }
+    file_size_ += bytes.size();
+    return true;
+}
+
+std::optional<std::string> TranslationCache::read(Location const& location) const
+{
+    if (fd_ < 0) {
+        return std::nullopt;
+    }
+
+    std::string result(location.size, '\0');
+    for (size_t done{0}; done < result.size();) {
+        auto const read{::pread(fd_, result.data() + done, result.size() - done,
+                                static_cast<off_t>(location.offset + done))};
+        if (read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (read <= 0) {
+            spdlog::error("{}(): failed to read \'{}\'", __FUNCTION__, path_.string());
+            return std::nullopt;
+        }
+        done += static_cast<size_t>(read);
+    }
+    return result;
+}
+
+void TranslationCache::compact()
+{
+    // records in the order they were written, the oldest ones are dropped first
+    std::vector<std::pair<std::string const*, Location>> records;
+    records.reserve(index_.size());
+    for (auto const& [key, location] : index_) {
+        records.emplace_back(&key, location);
+    }
+    std::ranges::sort(records, {}, [](auto const& r) { return r.second.offset; });
+
+    size_t kept_size{0};
+    auto first{records.size()};
+    while (first > 0 && kept_size + records[first - 1].second.record_size <= file_limit_ / 2) {
+        kept_size += records[--first].second.record_size;
+    }
+
+    std::vector<std::pair<std::string, std::string>> kept;
+    kept.reserve(records.size() - first);
+    for (auto i{first}; i < records.size(); ++i) {
+        if (auto translation{read(records[i].second)}) {
+            kept.emplace_back(*records[i].first, std::move(*translation));
+        }
+    }
+
+    try {
+        tools::file_utils::writeAtomically(path_, [&kept](std::ostream& output) {
+            tools::binary::Writer header{kHeaderSize};
+            header.writeBytes({reinterpret_cast<uint8_t const*>(kMagic.data()), kMagic.size()});
+            header.writeU16(kVersion);
+            output.write(reinterpret_cast<char const*>(header.data().data()),
+                         static_cast<std::streamsize>(header.data().size()));
+            for (auto const& [key, translation] : kept) {
+                tools::binary::Writer payload;
+                payload.writeString(key);
+                payload.writeString(translation);
+                tools::binary::Writer record;
+                tools::binary::writeRecord(record, payload.data());
+                output.write(reinterpret_cast<char const*>(record.data().data()),
+                             static_cast<std::streamsize>(record.data().size()));
+            }
+        });
+    } catch (std::exception const& ex) {
+        spdlog::error("{}(): failed to compact \'{}\': {}", __FUNCTION__, path_.string(),
+                      ex.what());
+        return;
+    }
+
+    auto const dropped{index_.size() - kept.size()};
+    close();
+    index_.clear();
+    dead_size_ = 0;
+    try {
+        open();
+        load();
+    } catch (std::exception const& ex) {
+        spdlog::error("{}(): {}, the file is not used anymore", __FUNCTION__, ex.what());
+        close();
+        index_.clear();
+        return;
+    }
+    spdlog::info("translation cache \'{}\' compacted, entries: {}, dropped: {}",
+                 path_.string(), index_.size(), dropped);
+}
+
+void TranslationCache::remember(std::string const& key, std::string translation)
+{
+    if (auto const it{lru_index_.find(key)}; it != lru_index_.end()) {
+        memory_size_ -= it->second->second.size();
+        lru_.erase(it->second);
+        lru_index_.erase(it);
+    }
+    if (translation.size() > memory_limit_) {
+        return;
+    }
+
+    memory_size_ += translation.size();
+    lru_.emplace_front(key, std::move(translation));
+    lru_index_[key] = lru_.begin();
+
+    while (memory_size_ > memory_limit_) {
+        auto const& last{lru_.back()};
+        memory_size_ -= last.second.size();
+        lru_index_.erase(last.first);
+        lru_.pop_back();
+    }
+}
+
+}  // namespace network
@@ -0,0 +1,111 @@
+#ifndef NETWORK_TRANSLATION_CACHE_H
+#define NETWORK_TRANSLATION_CACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace network {
+
+/**
+ * Translations received from the LLM server, so a word is requested once per model and
+ * prompt. Every entry is appended to the cache file, but only the file index (key, offset
+ * and size of the translation) and the recently used translations (LRU list limited by
+ * size) are kept in memory. Thread-safe, the responses are handled on the client thread.
+ *
+ * File layout (little-endian):
+ * | magic "VOCT" | u16 version | records... |
+ * record: | u32 payload size | u32 payload checksum | string key | string translation |
+ * A torn record (crash in the middle of an append) is cut off on open. The file is
+ * rewritten without the replaced records once they take more than a half of it, and
+ * without the oldest ones once it grows over the file limit.
+ */
+class TranslationCache final {
+public:
+    struct Key {
+        std::string word;  // normalized, see tools::string_utils::normalized()
+        std::string model;
+        uint64_t prompt_hash{};
+    };
+
+    struct Statistic {
+        size_t hits{};
+        size_t misses{};
+        size_t entries{};         // in the file
+        size_t memory_entries{};  // in the LRU list
+        size_t memory_size{};     // bytes of the translations in the LRU list
+        size_t file_size{};
+    };
+
+    static constexpr std::string_view kMagic{"VOCT"};
+    static constexpr uint16_t kVersion{1};
+
+    static Key makeKey(std::string_view word, std::string_view model, std::string_view prompt);
+
+    /**
+     * @param path cache file, it's created if it doesn't exist; empty path - no file
+     * @param memory_limit max size of the translations kept in memory, bytes
+     * @param file_limit max size of the file, bytes
+     * @throw GlobalError if the file can not be opened or it's not a cache file
+     */
+    TranslationCache(std::filesystem::path path, size_t memory_limit, size_t file_limit);
+    ~TranslationCache();
+    TranslationCache(TranslationCache const& other) = delete;
+    TranslationCache& operator=(TranslationCache const& other) = delete;
+
+    std::optional<std::string> find(Key const& key);
+    /**
+     * Replaces the translation if the key is already cached. A failed write is logged,
+     * the translation is cached in memory only in this case.
+     */
+    void insert(Key const& key, std::string_view translation);
+
+    Statistic statistic() const;
+
+private:
+    static constexpr size_t kHeaderSize{4 + 2};
+
+    // location of the translation in the file
+    struct Location {
+        size_t offset{};
+        size_t size{};
+        size_t record_size{};
+    };
+
+    using Lru = std::list<std::pair<std::string, std::string>>;
+
+    std::filesystem::path path_;
+    size_t memory_limit_;
+    size_t file_limit_;
+
+    mutable std::mutex mutex_;
+    int fd_{-1};
+    size_t file_size_{0};
+    size_t dead_size_{0};  // replaced records
+    std::unordered_map<std::string, Location> index_;
+    Lru lru_;
+    std::unordered_map<std::string, Lru::iterator> lru_index_;
+    size_t memory_size_{0};
+    size_t hits_{0};
+    size_t misses_{0};
+
+    static std::string serialize(Key const& key);
+
+    void open();
+    void load();
+    void close();
+    bool append(std::string const& key, std::string_view translation);
+    std::optional<std::string> read(Location const& location) const;
+    void compact();
+    void remember(std::string const& key, std::string translation);
+};
+
+}  // namespace network
+
+#endif  // NETWORK_TRANSLATION_CACHE_H
@@ -0,0 +1,203 @@
+#ifndef TOOLS_BINARY_STREAM_H
+#define TOOLS_BINARY_STREAM_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/exceptions/parsing_error.h"
+
+// Helpers for the length-prefixed binary formats.
+// All integers are stored in little-endian byte order regardless of the host,
+// strings are stored as u32 length followed by raw bytes (no terminating zero).
+namespace tools::binary {
+
+class Writer {
+public:
+    Writer() = default;
+    explicit Writer(size_t reserve) { buffer_.reserve(reserve); }
+
+    void writeU8(uint8_t value) { buffer_.push_back(value); }
+    void writeU16(uint16_t value) { writeLittleEndian(value); }
+    void writeU32(uint32_t value) { writeLittleEndian(value); }
+    void writeU64(uint64_t value) { writeLittleEndian(value); }
+    void writeI32(int32_t value) { writeLittleEndian(static_cast<uint32_t>(value)); }
+    void writeI64(int64_t value) { writeLittleEndian(static_cast<uint64_t>(value)); }
+    // IEEE 754 binary64
+    void writeF64(double value) { writeLittleEndian(std::bit_cast<uint64_t>(value)); }
+
+    void writeBytes(std::span<uint8_t const> bytes)
+    {
+        buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());
+    }
+
+    void writeString(std::string_view str)
+    {
+        writeU32(static_cast<uint32_t>(str.size()));
+        buffer_.insert(buffer_.end(), str.begin(), str.end());
+    }
+
+    void writeStrings(std::vector<std::string> const& strs)
+    {
+        writeU32(static_cast<uint32_t>(strs.size()));
+        for (auto const& s : strs) {
+            writeString(s);
+        }
+    }
+
+    void writeStrings(std::span<std::string_view const> strs)
+    {
+        writeU32(static_cast<uint32_t>(strs.size()));
+        for (auto const s : strs) {
+            writeString(s);
+        }
+    }
+
+    std::vector<uint8_t> const& data() const { return buffer_; }
+    std::vector<uint8_t> release() { return std::move(buffer_); }
+
+private:
+    std::vector<uint8_t> buffer_;
+
+    template <typename UIntT>
+    void writeLittleEndian(UIntT value)
+    {
+        for (size_t i{0}; i < sizeof(UIntT); ++i) {
+            buffer_.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+};
+
+/**
+ * Reads values from the buffer it doesn't own, so the buffer must outlive the reader
+ * and every string_view returned by readString()
+ * @throw ParsingError on every read beyond the end of the buffer
+ */
+class Reader {
+public:
+    explicit Reader(std::span<uint8_t const> data)
+        : data_{data}
+    {}
+
+    uint8_t readU8()
+    {
+        require(1);
+        return data_[offset_++];
+    }
+    uint16_t readU16() { return readLittleEndian<uint16_t>(); }
+    uint32_t readU32() { return readLittleEndian<uint32_t>(); }
+    uint64_t readU64() { return readLittleEndian<uint64_t>(); }
+    int32_t readI32() { return static_cast<int32_t>(readLittleEndian<uint32_t>()); }
+    int64_t readI64() { return static_cast<int64_t>(readLittleEndian<uint64_t>()); }
+    double readF64() { return std::bit_cast<double>(readLittleEndian<uint64_t>()); }
+
+    std::span<uint8_t const> readBytes(size_t count)
+    {
+        require(count);
+        auto const result{data_.subspan(offset_, count)};
+        offset_ += count;
+        return result;
+    }
+
+    std::string_view readString()
+    {
+        auto const size{readU32()};
+        auto const bytes{readBytes(size)};
+        return {reinterpret_cast<char const*>(bytes.data()), bytes.size()};
+    }
+
+    std::vector<std::string> readStrings()
+    {
+        auto const count{readU32()};
+        std::vector<std::string> result;
+        result.reserve(std::min<size_t>(count, left()));
+        for (uint32_t i{0}; i < count; ++i) {
+            result.emplace_back(readString());
+        }
+        return result;
+    }
+
+    size_t offset() const { return offset_; }
+    size_t left() const { return data_.size() - offset_; }
+    bool atEnd() const { return offset_ == data_.size(); }
+
+private:
+    std::span<uint8_t const> data_;
+    size_t offset_{0};
+
+    void require(size_t count) const
+    {
+        if (left() < count) {
+            throw ParsingError("binary data is truncated: " + std::to_string(count) +
+                               " bytes requested, " + std::to_string(left()) + " left");
+        }
+    }
+
+    template <typename UIntT>
+    UIntT readLittleEndian()
+    {
+        require(sizeof(UIntT));
+        UIntT value{0};
+        for (size_t i{0}; i < sizeof(UIntT); ++i) {
+            value |= static_cast<UIntT>(data_[offset_ + i]) << (8 * i);
+        }
+        offset_ += sizeof(UIntT);
+        return value;
+    }
+};
+
+// Checksummed records of the append-only files (vocabulary journal, translation cache):
+// | u32 payload size | u32 payload checksum | payload... |
+// A record torn by a crash or garbage at the end of the file fails the checksum.
+
+constexpr size_t kRecordHeaderSize{sizeof(uint32_t) + sizeof(uint32_t)};
+
+// FNV-1a, good enough to detect a torn or garbage record
+inline uint32_t checksum(std::span<uint8_t const> data)
+{
+    uint32_t hash{2166136261u};
+    for (auto const byte : data) {
+        hash ^= byte;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+inline void writeRecord(Writer& writer, std::span<uint8_t const> payload)
+{
+    writer.writeU32(static_cast<uint32_t>(payload.size()));
+    writer.writeU32(checksum(payload));
+    writer.writeBytes(payload);
+}
+
+/**
+ * Payload of the record at the beginning of `data`, the record takes
+ * kRecordHeaderSize + payload size bytes
+ * @return nullopt if the record is truncated or its checksum doesn't match
+ */
+inline std::optional<std::span<uint8_t const>> readRecord(std::span<uint8_t const> data)
+{
+    Reader reader{data};
+    if (reader.left() < kRecordHeaderSize) {
+        return std::nullopt;
+    }
+    auto const size{reader.readU32()};
+    auto const expected_checksum{reader.readU32()};
+    if (reader.left() < size) {
+        return std::nullopt;
+    }
+    auto const payload{reader.readBytes(size)};
+    if (checksum(payload) != expected_checksum) {
+        return std::nullopt;
+    }
+    return payload;
+}
+
+}  // namespace tools::binary
+
+#endif  // TOOLS_BINARY_STREAM_H
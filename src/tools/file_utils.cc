@@ -0,0 +1,66 @@
+#include "file_utils.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "common/exceptions/global_error.h"
+
+namespace {
+
+void syncPath(std::filesystem::path const& path, int flags)
+{
+    auto const fd{::open(path.c_str(), flags | O_CLOEXEC)};
+    if (fd < 0) {
+        throw GlobalError("failed to open \'" + path.string() + "\': " + std::strerror(errno));
+    }
+    auto const result{::fsync(fd)};
+    auto const error{errno};
+    ::close(fd);
+    if (result != 0) {
+        throw GlobalError("failed to sync \'" + path.string() + "\': " + std::strerror(error));
+    }
+}
+
+}  // namespace
+
+namespace tools::file_utils {
+
+void writeAtomically(std::filesystem::path const& path,
+                     std::function<void(std::ostream&)> const& writer)
+{
+    auto tmp_path{path};
+    tmp_path += ".tmp";
+
+    try {
+        {
+            std::ofstream output(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!output) {
+                throw GlobalError("failed to open \'" + tmp_path.string() + "\'");
+            }
+            writer(output);
+            if (!output.flush()) {
+                throw GlobalError("failed to write \'" + tmp_path.string() + "\'");
+            }
+        }
+        syncFile(tmp_path);
+        std::filesystem::rename(tmp_path, path);
+    } catch (...) {
+        std::error_code ec;
+        std::filesystem::remove(tmp_path, ec);
+        throw;
+    }
+
+    // make the rename itself durable
+    auto const dir{path.has_parent_path() ? path.parent_path()
+                                          : std::filesystem::path{"."}};
+    syncPath(dir, O_RDONLY | O_DIRECTORY);
+}
+
+void syncFile(std::filesystem::path const& path) { syncPath(path, O_RDONLY); }
+
+}  // namespace tools::file_utils
@@ -0,0 +1,26 @@
+#ifndef TOOLS_FILE_UTILS_H
+#define TOOLS_FILE_UTILS_H
+
+#include <filesystem>
+#include <functional>
+#include <ostream>
+
+namespace tools::file_utils {
+
+/**
+ * Writes the file through a temporary file next to it: the data is written by `writer`,
+ * flushed to the disk (fsync) and the temporary file is renamed over `path`.
+ * So `path` contains either old or new data even if the process crashes in the middle.
+ * @throw GlobalError if any step fails (the temporary file is removed in this case)
+ */
+void writeAtomically(std::filesystem::path const& path,
+                     std::function<void(std::ostream&)> const& writer);
+
+/**
+ * @throw GlobalError if file can not be opened or synced
+ */
+void syncFile(std::filesystem::path const& path);
+
+}  // namespace tools::file_utils
+
+#endif  // TOOLS_FILE_UTILS_H
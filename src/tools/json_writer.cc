@@ -0,0 +1,179 @@
+#include "json_writer.h"
+
+#include <cmath>
+
+namespace tools::json {
+
+StreamWriter::StreamWriter(std::ostream& out, int indent)
+    : out_{out}
+    , indent_{indent}
+{
+    buffer_.reserve(kBufferSize + 1024);
+}
+
+StreamWriter::~StreamWriter() { flush(); }
+
+StreamWriter& StreamWriter::beginObject()
+{
+    beforeValue();
+    write('{');
+    scopes_.push_back({.is_object = true, .empty = true});
+    return *this;
+}
+
+StreamWriter& StreamWriter::endObject()
+{
+    auto const scope{scopes_.back()};
+    scopes_.pop_back();
+    if (!scope.empty) {
+        newLine();
+    }
+    write('}');
+    return *this;
+}
+
+StreamWriter& StreamWriter::beginArray()
+{
+    beforeValue();
+    write('[');
+    scopes_.push_back({.is_object = false, .empty = true});
+    return *this;
+}
+
+StreamWriter& StreamWriter::endArray()
+{
+    auto const scope{scopes_.back()};
+    scopes_.pop_back();
+    if (!scope.empty) {
+        newLine();
+    }
+    write(']');
+    return *this;
+}
+
+StreamWriter& StreamWriter::key(std::string_view key)
+{
+    beforeValue();
+    writeEscaped(key);
+    write(indent_ < 0 ? ":" : ": ");
+    after_key_ = true;
+    return *this;
+}
+
+StreamWriter& StreamWriter::value(std::string_view value)
+{
+    beforeValue();
+    writeEscaped(value);
+    return *this;
+}
+
+StreamWriter& StreamWriter::value(bool value)
+{
+    beforeValue();
+    write(value ? "true" : "false");
+    return *this;
+}
+
+StreamWriter& StreamWriter::value(double value)
+{
+    beforeValue();
+    if (!std::isfinite(value)) {
+        write("null");
+        return *this;
+    }
+
+    char buffer[32];
+    auto const [end, ec]{std::to_chars(std::begin(buffer), std::end(buffer), value)};
+    std::string_view const str{buffer, static_cast<size_t>(end - buffer)};
+    write(str);
+    // integral values keep the fraction part to be read back as floating point numbers
+    if (str.find_first_of(".eE") == std::string_view::npos) {
+        write(".0");
+    }
+    return *this;
+}
+
+StreamWriter& StreamWriter::value(std::vector<std::string> const& values)
+{
+    beginArray();
+    for (auto const& v : values) {
+        value(std::string_view{v});
+    }
+    return endArray();
+}
+
+StreamWriter& StreamWriter::value(std::span<std::string_view const> values)
+{
+    beginArray();
+    for (auto const v : values) {
+        value(v);
+    }
+    return endArray();
+}
+
+void StreamWriter::flush()
+{
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+}
+
+// private ================================================
+
+void StreamWriter::beforeValue()
+{
+    if (after_key_) {
+        after_key_ = false;
+        return;
+    }
+    if (scopes_.empty()) {
+        return;
+    }
+    if (!scopes_.back().empty) {
+        write(',');
+    }
+    scopes_.back().empty = false;
+    newLine();
+}
+
+void StreamWriter::newLine()
+{
+    if (indent_ < 0) {
+        return;
+    }
+    write('\n');
+    buffer_.append(scopes_.size() * static_cast<size_t>(indent_), ' ');
+}
+
+void StreamWriter::writeEscaped(std::string_view str)
+{
+    static constexpr char kHex[]{"0123456789abcdef"};
+
+    write('"');
+    auto begin{str.begin()};
+    for (auto it{str.begin()}; it != str.end(); ++it) {
+        auto const ch{static_cast<unsigned char>(*it)};
+        if (ch >= 0x20 && ch != '"' && ch != '\\') {
+            continue;
+        }
+        buffer_.append(begin, it);  // flush the plain part before the escaped char
+        begin = std::next(it);
+        switch (ch) {
+        case '"': buffer_.append("\\\""); break;
+        case '\\': buffer_.append("\\\\"); break;
+        case '\b': buffer_.append("\\b"); break;
+        case '\f': buffer_.append("\\f"); break;
+        case '\n': buffer_.append("\\n"); break;
+        case '\r': buffer_.append("\\r"); break;
+        case '\t': buffer_.append("\\t"); break;
+        default:
+            buffer_.append("\\u00");
+            buffer_.push_back(kHex[ch >> 4]);
+            buffer_.push_back(kHex[ch & 0x0F]);
+            break;
+        }
+    }
+    buffer_.append(begin, str.end());
+    write('"');
+}
+
+}  // namespace tools::json
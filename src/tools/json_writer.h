@@ -0,0 +1,96 @@
+#ifndef TOOLS_JSON_WRITER_H
+#define TOOLS_JSON_WRITER_H
+
+#include <charconv>
+#include <concepts>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tools::json {
+
+/**
+ * Writes json straight into the output stream without building a DOM.
+ * The output is the same as nlohmann::json::dump(indent) would produce for the same
+ * document: indent < 0 gives compact output, otherwise the document is pretty-printed
+ * with `indent` spaces per level.
+ * Strings are expected to be utf-8 and are written as is, only the characters required
+ * by json are escaped.
+ */
+class StreamWriter {
+public:
+    static size_t const kBufferSize{64 * 1024};
+
+    explicit StreamWriter(std::ostream& out, int indent = -1);
+    ~StreamWriter();
+
+    StreamWriter(StreamWriter const& other) = delete;
+    StreamWriter& operator=(StreamWriter const& other) = delete;
+
+    StreamWriter& beginObject();
+    StreamWriter& endObject();
+    StreamWriter& beginArray();
+    StreamWriter& endArray();
+
+    StreamWriter& key(std::string_view key);
+
+    StreamWriter& value(std::string_view value);
+    StreamWriter& value(char const* value) { return this->value(std::string_view{value}); }
+    StreamWriter& value(bool value);
+
+    template <std::integral ValueT>
+    StreamWriter& value(ValueT value)
+    {
+        beforeValue();
+        char buffer[24];
+        auto const [end, ec]{std::to_chars(std::begin(buffer), std::end(buffer), value)};
+        write({buffer, static_cast<size_t>(end - buffer)});
+        return *this;
+    }
+
+    // shortest representation which is read back to the same value, as nlohmann does
+    StreamWriter& value(double value);
+
+    StreamWriter& value(std::vector<std::string> const& values);
+    StreamWriter& value(std::span<std::string_view const> values);
+
+    // moves buffered data to the output stream
+    void flush();
+
+private:
+    struct Scope {
+        bool is_object;
+        bool empty;
+    };
+
+    std::ostream& out_;
+    int indent_;
+    std::string buffer_;
+    std::vector<Scope> scopes_;
+    bool after_key_{false};
+
+    void beforeValue();
+    void newLine();
+    void writeEscaped(std::string_view str);
+
+    void write(std::string_view str)
+    {
+        buffer_.append(str);
+        if (buffer_.size() >= kBufferSize) {
+            flush();
+        }
+    }
+    void write(char ch)
+    {
+        buffer_.push_back(ch);
+        if (buffer_.size() >= kBufferSize) {
+            flush();
+        }
+    }
+};
+
+}  // namespace tools::json
+
+#endif  // TOOLS_JSON_WRITER_H
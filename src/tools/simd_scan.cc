@@ -0,0 +1,309 @@
+#include "simd_scan.h"
+
+#include <bit>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define TOOLS_SIMD_SSE2 1
+#if defined(__GNUC__) || defined(__clang__)
+#define TOOLS_SIMD_AVX2 1
+#endif
+#endif
+
+namespace {
+
+constexpr auto npos{std::string_view::npos};
+
+bool isBlank(char ch, tools::simd::Blanks blanks)
+{
+    return ch == ' ' || ch == '\t' ||
+           (blanks == tools::simd::Blanks::kSpacesTabsAndNewLines && ch == '\n');
+}
+
+// scalar =================================================
+
+std::size_t findScalar(char const* data, std::size_t size, std::size_t pos, char ch)
+{
+    for (; pos < size; ++pos) {
+        if (data[pos] == ch) {
+            return pos;
+        }
+    }
+    return npos;
+}
+
+std::size_t findFirstNotBlankScalar(char const* data, std::size_t size, std::size_t pos,
+                                    tools::simd::Blanks blanks)
+{
+    for (; pos < size; ++pos) {
+        if (!isBlank(data[pos], blanks)) {
+            return pos;
+        }
+    }
+    return npos;
+}
+
+// `end` is the position after the last character to be checked
+std::size_t findLastNotBlankScalar(char const* data, std::size_t end,
+                                   tools::simd::Blanks blanks)
+{
+    while (end > 0) {
+        if (!isBlank(data[--end], blanks)) {
+            return end;
+        }
+    }
+    return npos;
+}
+
+#if TOOLS_SIMD_SSE2
+
+// SSE2 ===================================================
+
+std::size_t findSse2(char const* data, std::size_t size, std::size_t pos, char ch)
+{
+    auto const needle{_mm_set1_epi8(ch)};
+    for (; pos + 16 <= size; pos += 16) {
+        auto const chunk{_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + pos))};
+        if (auto const mask{static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)))}) {
+            return pos + std::countr_zero(mask);
+        }
+    }
+    return findScalar(data, size, pos, ch);
+}
+
+// bit is set for every blank character of the chunk
+uint32_t blanksMaskSse2(__m128i chunk, tools::simd::Blanks blanks)
+{
+    auto matches{_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')),
+                              _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')))};
+    if (blanks == tools::simd::Blanks::kSpacesTabsAndNewLines) {
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')));
+    }
+    return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+}
+
+std::size_t findFirstNotBlankSse2(char const* data, std::size_t size,
+                                  tools::simd::Blanks blanks)
+{
+    std::size_t pos{0};
+    for (; pos + 16 <= size; pos += 16) {
+        auto const chunk{_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + pos))};
+        if (auto const mask{~blanksMaskSse2(chunk, blanks) & 0xFFFFu}) {
+            return pos + std::countr_zero(mask);
+        }
+    }
+    return findFirstNotBlankScalar(data, size, pos, blanks);
+}
+
+std::size_t findLastNotBlankSse2(char const* data, std::size_t size,
+                                 tools::simd::Blanks blanks)
+{
+    auto end{size};
+    for (; end >= 16; end -= 16) {
+        auto const chunk{_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + end - 16))};
+        if (auto const mask{~blanksMaskSse2(chunk, blanks) & 0xFFFFu}) {
+            return end - 16 + (31 - std::countl_zero(mask));
+        }
+    }
+    return findLastNotBlankScalar(data, end, blanks);
+}
+
+#endif  // TOOLS_SIMD_SSE2
+
+#if TOOLS_SIMD_AVX2
+
+// AVX2 ===================================================
+
+__attribute__((target("avx2"))) std::size_t findAvx2(char const* data, std::size_t size,
+                                                     std::size_t pos, char ch)
+{
+    auto const needle{_mm256_set1_epi8(ch)};
+    for (; pos + 32 <= size; pos += 32) {
+        auto const chunk{_mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + pos))};
+        if (auto const mask{static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)))}) {
+            return pos + std::countr_zero(mask);
+        }
+    }
+    return findSse2(data, size, pos, ch);
+}
+
+__attribute__((target("avx2"))) uint32_t blanksMaskAvx2(__m256i chunk,
+                                                        tools::simd::Blanks blanks)
+{
+    auto matches{_mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')),
+                                 _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t')))};
+    if (blanks == tools::simd::Blanks::kSpacesTabsAndNewLines) {
+        matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n')));
+    }
+    return static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+}
+
+__attribute__((target("avx2"))) std::size_t findFirstNotBlankAvx2(
+    char const* data, std::size_t size, tools::simd::Blanks blanks)
+{
+    std::size_t pos{0};
+    for (; pos + 32 <= size; pos += 32) {
+        auto const chunk{_mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + pos))};
+        if (auto const mask{~blanksMaskAvx2(chunk, blanks)}) {
+            return pos + std::countr_zero(mask);
+        }
+    }
+    if (auto const result{findFirstNotBlankSse2(data + pos, size - pos, blanks)};
+        result != npos) {
+        return pos + result;
+    }
+    return npos;
+}
+
+__attribute__((target("avx2"))) std::size_t findLastNotBlankAvx2(
+    char const* data, std::size_t size, tools::simd::Blanks blanks)
+{
+    auto end{size};
+    for (; end >= 32; end -= 32) {
+        auto const chunk{
+            _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + end - 32))};
+        if (auto const mask{~blanksMaskAvx2(chunk, blanks)}) {
+            return end - 32 + (31 - std::countl_zero(mask));
+        }
+    }
+    return findLastNotBlankSse2(data, end, blanks);
+}
+
+#endif  // TOOLS_SIMD_AVX2
+
+using tools::simd::Implementation;
+
+bool isSupported(Implementation implementation)
+{
+    switch (implementation) {
+#if TOOLS_SIMD_AVX2
+    case Implementation::kAvx2:
+        // the detection runs in a static initializer, maybe before the one of libgcc
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+#if TOOLS_SIMD_SSE2
+    case Implementation::kSse2:
+        return true;
+#endif
+    case Implementation::kScalar:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Implementation detectImplementation()
+{
+    for (auto const implementation : {Implementation::kAvx2, Implementation::kSse2}) {
+        if (isSupported(implementation)) {
+            return implementation;
+        }
+    }
+    return Implementation::kScalar;
+}
+
+Implementation implementation_{detectImplementation()};
+
+// shorter strings are not worth the vector setup
+constexpr std::size_t kMinVectorSize{16};
+
+}  // namespace
+
+namespace tools::simd {
+
+std::size_t find(std::string_view str, char ch, std::size_t pos)
+{
+    auto const* data{str.data()};
+    auto const size{str.size()};
+    if (pos >= size) {
+        return npos;
+    }
+    if (size - pos < kMinVectorSize) {
+        return findScalar(data, size, pos, ch);
+    }
+
+    switch (implementation_) {
+#if TOOLS_SIMD_AVX2
+    case Implementation::kAvx2:
+        return findAvx2(data, size, pos, ch);
+#endif
+#if TOOLS_SIMD_SSE2
+    case Implementation::kSse2:
+        return findSse2(data, size, pos, ch);
+#endif
+    default:
+        return findScalar(data, size, pos, ch);
+    }
+}
+
+std::size_t findFirstNotBlank(std::string_view str, Blanks blanks)
+{
+    // the first character decides in most of the cases
+    if (str.size() < kMinVectorSize || !isBlank(str.front(), blanks)) {
+        return findFirstNotBlankScalar(str.data(), str.size(), 0, blanks);
+    }
+
+    switch (implementation_) {
+#if TOOLS_SIMD_AVX2
+    case Implementation::kAvx2:
+        return findFirstNotBlankAvx2(str.data(), str.size(), blanks);
+#endif
+#if TOOLS_SIMD_SSE2
+    case Implementation::kSse2:
+        return findFirstNotBlankSse2(str.data(), str.size(), blanks);
+#endif
+    default:
+        return findFirstNotBlankScalar(str.data(), str.size(), 0, blanks);
+    }
+}
+
+std::size_t findLastNotBlank(std::string_view str, Blanks blanks)
+{
+    if (str.size() < kMinVectorSize || !isBlank(str.back(), blanks)) {
+        return findLastNotBlankScalar(str.data(), str.size(), blanks);
+    }
+
+    switch (implementation_) {
+#if TOOLS_SIMD_AVX2
+    case Implementation::kAvx2:
+        return findLastNotBlankAvx2(str.data(), str.size(), blanks);
+#endif
+#if TOOLS_SIMD_SSE2
+    case Implementation::kSse2:
+        return findLastNotBlankSse2(str.data(), str.size(), blanks);
+#endif
+    default:
+        return findLastNotBlankScalar(str.data(), str.size(), blanks);
+    }
+}
+
+std::string_view implementation() { return name(implementation_); }
+
+std::string_view name(Implementation implementation)
+{
+    switch (implementation) {
+    case Implementation::kAvx2:
+        return "avx2";
+    case Implementation::kSse2:
+        return "sse2";
+    default:
+        return "scalar";
+    }
+}
+
+bool supported(Implementation implementation) { return isSupported(implementation); }
+
+bool setImplementation(Implementation implementation)
+{
+    if (!isSupported(implementation)) {
+        return false;
+    }
+    implementation_ = implementation;
+    return true;
+}
+
+}  // namespace tools::simd
@@ -0,0 +1,53 @@
+#ifndef TOOLS_SIMD_SCAN_H
+#define TOOLS_SIMD_SCAN_H
+
+#include <string_view>
+
+// Vectorized byte scanning used by tools::string_utils.
+// AVX2 is used if the CPU supports it (checked once at run time), SSE2 otherwise on x86-64,
+// other platforms get the scalar implementation. Strings shorter than a vector register
+// are always scanned by the scalar code.
+namespace tools::simd {
+
+// "blank" characters are ' ' and '\t', as removePrefixSpacesAndTabs() treats them
+enum class Blanks {
+    kSpacesAndTabs,
+    kSpacesTabsAndNewLines,
+};
+
+/**
+ * @return position of the first `ch` at or after `pos`, std::string_view::npos if none
+ */
+std::size_t find(std::string_view str, char ch, std::size_t pos = 0);
+
+/**
+ * @return position of the first non-blank character, std::string_view::npos if none
+ */
+std::size_t findFirstNotBlank(std::string_view str, Blanks blanks = Blanks::kSpacesAndTabs);
+
+/**
+ * @return position of the last non-blank character, std::string_view::npos if none
+ */
+std::size_t findLastNotBlank(std::string_view str, Blanks blanks = Blanks::kSpacesAndTabs);
+
+enum class Implementation {
+    kScalar,
+    kSse2,
+    kAvx2,
+};
+
+// name of the implementation in use: "avx2", "sse2" or "scalar"
+std::string_view implementation();
+std::string_view name(Implementation implementation);
+
+bool supported(Implementation implementation);
+/**
+ * Replaces the implementation detected at start, so the tests and the benchmarks can
+ * compare them. It's not synchronized with the scans running on other threads.
+ * @return false if the CPU (or the build) doesn't support it, nothing is changed then
+ */
+bool setImplementation(Implementation implementation);
+
+}  // namespace tools::simd
+
+#endif  // TOOLS_SIMD_SCAN_H
@@ -0,0 +1,46 @@
+#include "string_arena.h"
+
+#include <algorithm>
+
+namespace tools {
+
+std::string_view StringArena::store(std::string_view str)
+{
+    if (str.empty()) {
+        return {};
+    }
+
+    if (str.size() > left_) {
+        auto const block_size{std::max(kBlockSize, str.size())};
+        blocks_.push_back(std::make_unique_for_overwrite<char[]>(block_size));
+        capacity_ += block_size;
+        // the rest of the current block is kept for the short strings if the new
+        // block is a dedicated one for the long string
+        if (block_size == kBlockSize || left_ == 0) {
+            current_ = blocks_.back().get();
+            left_ = block_size;
+        } else {
+            std::copy(str.begin(), str.end(), blocks_.back().get());
+            size_ += str.size();
+            return {blocks_.back().get(), str.size()};
+        }
+    }
+
+    auto* const data{current_};
+    std::copy(str.begin(), str.end(), data);
+    current_ += str.size();
+    left_ -= str.size();
+    size_ += str.size();
+    return {data, str.size()};
+}
+
+void StringArena::clear()
+{
+    blocks_.clear();
+    current_ = nullptr;
+    left_ = 0;
+    size_ = 0;
+    capacity_ = 0;
+}
+
+}  // namespace tools
@@ -0,0 +1,43 @@
+#ifndef TOOLS_STRING_ARENA_H
+#define TOOLS_STRING_ARENA_H
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace tools {
+
+/**
+ * Append-only storage of strings in big blocks. Stored strings never move, so the
+ * returned string_views stay valid until the arena is cleared or destroyed.
+ * Strings longer than a block get a block of their own.
+ */
+class StringArena final {
+public:
+    static constexpr size_t kBlockSize{64 * 1024};
+
+    StringArena() = default;
+    StringArena(StringArena&& other) = default;
+    StringArena& operator=(StringArena&& other) = default;
+    StringArena(StringArena const& other) = delete;
+    StringArena& operator=(StringArena const& other) = delete;
+
+    std::string_view store(std::string_view str);
+    void clear();
+
+    // bytes used by the stored strings
+    size_t size() const { return size_; }
+    // bytes allocated for the blocks
+    size_t capacity() const { return capacity_; }
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* current_{nullptr};
+    size_t left_{0};
+    size_t size_{0};
+    size_t capacity_{0};
+};
+
+}  // namespace tools
+
+#endif  // TOOLS_STRING_ARENA_H
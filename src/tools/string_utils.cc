@@ -1,6 +1,5 @@
 #include "string_utils.h"
 
-#include <sstream>
 #include <algorithm>
 
 namespace tools::string_utils {
@@ -21,22 +20,13 @@ void removeSuffix(std::string& str, char ch)
 
 void removePrefixSpacesAndTabs(std::string& str)
 {
-    auto count{0UL};
-    while ((count != str.size()) && ((str.at(count) == ' ') || (str.at(count) == '\t'))) {
-        ++count;
-    }
-    str.erase(0, count);
+    str.erase(0, std::min(simd::findFirstNotBlank(str), str.size()));
 }
 
 void removeSuffixSpacesAndTabs(std::string& str)
 {
-    auto index{str.size()};
-    while ((0 < index) && ((str.at(index - 1) == ' ') || (str.at(index - 1) == '\t') || (str.at(index - 1) == '\n'))) {
-        --index;
-    }
-    if (index < str.size()) {
-        str.erase(index);
-    }
+    auto const index{simd::findLastNotBlank(str, simd::Blanks::kSpacesTabsAndNewLines)};
+    str.erase(index == std::string::npos ? 0 : index + 1);
 }
 
 void trim(std::string& str)
@@ -48,14 +38,61 @@ void trim(std::string& str)
 std::vector<std::string> split(std::string_view str, char delimiter)
 {
     std::vector<std::string> tokens;
-    std::string token;
-    std::istringstream tokenStream(std::string{str});
-    while (std::getline(tokenStream, token, delimiter)) {
-        if (!token.empty()) {
-            tokens.push_back(token);
+    forEachToken(str, delimiter,
+                 [&tokens](std::string_view token) { tokens.emplace_back(token); });
+    return tokens;
+}
+
+std::vector<std::string_view> splitView(std::string_view str, char delimiter)
+{
+    std::vector<std::string_view> tokens;
+    forEachToken(str, delimiter,
+                 [&tokens](std::string_view token) { tokens.push_back(token); });
+    return tokens;
+}
+
+std::string_view withoutPrefix(std::string_view str, char ch)
+{
+    if (const auto index = str.find_first_not_of(ch); index != std::string_view::npos) {
+        str.remove_prefix(index);
+    }
+    return str;
+}
+
+std::string_view withoutSuffix(std::string_view str, char ch)
+{
+    if (const auto index = str.find_last_not_of(ch); index != std::string_view::npos) {
+        str.remove_suffix(str.size() - index - 1);
+    }
+    return str;
+}
+
+std::string_view withoutPrefixSpacesAndTabs(std::string_view str)
+{
+    auto const index{simd::findFirstNotBlank(str)};
+    return index == std::string_view::npos ? std::string_view{} : str.substr(index);
+}
+
+std::string_view withoutSuffixSpacesAndTabs(std::string_view str)
+{
+    auto const index{simd::findLastNotBlank(str, simd::Blanks::kSpacesTabsAndNewLines)};
+    return index == std::string_view::npos ? std::string_view{} : str.substr(0, index + 1);
+}
+
+std::string_view trimmed(std::string_view str)
+{
+    return withoutSuffixSpacesAndTabs(withoutPrefixSpacesAndTabs(str));
+}
+
+std::string normalized(std::string_view str)
+{
+    std::string result{trimmed(str)};
+    for (auto& ch : result) {
+        if (ch >= 'A' && ch <= 'Z') {
+            ch = static_cast<char>(ch - 'A' + 'a');
         }
     }
-    return tokens;
+    return result;
 }
 
 std::string codepoint_to_utf8(int codepoint) {
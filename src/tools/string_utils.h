@@ -5,6 +5,8 @@
 #include <string_view>
 #include <vector>
 
+#include "tools/simd_scan.h"
+
 namespace tools::string_utils {
 
 void removePrefix(std::string& str, char ch);
@@ -19,6 +21,44 @@ void trim(std::string& str);
 
 std::vector<std::string> split(std::string_view str, char delimiter);
 
+// string_view versions, they return a slice of the argument and never allocate
+
+std::string_view withoutPrefix(std::string_view str, char ch);
+
+std::string_view withoutSuffix(std::string_view str, char ch);
+
+std::string_view withoutPrefixSpacesAndTabs(std::string_view str);
+
+std::string_view withoutSuffixSpacesAndTabs(std::string_view str);
+
+std::string_view trimmed(std::string_view str);
+
+// trimmed copy with ASCII letters in lower case, used as a key for case-insensitive lookups
+std::string normalized(std::string_view str);
+
+/**
+ * Same tokens as split(), but as slices of the argument
+ */
+std::vector<std::string_view> splitView(std::string_view str, char delimiter);
+
+/**
+ * Calls `callback(std::string_view)` for every non-empty token, as split() returns them
+ */
+template <typename Callback>
+void forEachToken(std::string_view str, char delimiter, Callback&& callback)
+{
+    while (!str.empty()) {
+        auto const end{simd::find(str, delimiter)};
+        if (auto const token{str.substr(0, end)}; !token.empty()) {
+            callback(token);
+        }
+        if (end == std::string_view::npos) {
+            break;
+        }
+        str.remove_prefix(end + 1);
+    }
+}
+
 std::string codepoint_to_utf8(int codepoint);
 
 std::string toLowerCase(const std::string& str);
@@ -1,14 +1,18 @@
 #include "main_window.h"
 
 #include <array>
+#include <chrono>
+#include <filesystem>
 #include <functional>
 #include <map>
 #include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 
+#include "network/chat_completion.h"
 #include "network/http/client/nttp_client.h"
-#include "nlohmann/json.hpp"
 #include "spdlog/spdlog.h"
 
 #include "common/events/event_dispatcher.h"
@@ -17,10 +21,29 @@
 #include "ui/events/text_input_event.h"
 #include "ui/tools/font_manager.h"
 #include "ui/tools/locale.h"
+#include "vocabulary/events/vocabulary_saved_event.h"
 #include "vocabulary/translation.h"
 #include "vocabulary/vocabulary.h"
 #include "vocabulary/word.h"
 
+namespace {
+
+// system prompt of the translation requests, its hash is a part of the translation cache key
+constexpr std::string_view kTranslationPrompt{
+    "Ты переводчик русского и английского языков.\n"
+    "Ты должен предоставлять перевод слов и словосочетаний на русский язык, "
+    "а также пример использования этого слова или словосочетания в предложении. "
+    "Ответ должен состоять из одной строки, а формат ответа должен строго "
+    "соответствовать следующему шаблону:\n"
+    "\"<русский вариант 1> ; <русский вариант 2> | "
+    "<Пример использования слова или словосочетания в предложении на английском языке>\"\n\n"
+    "Например\nслово:\n\"fine\"\nответ:\n"
+    "\"хорошо ; отлично | I'm fine, thank you for asking.\"\n\n"
+    "Если запрашиваемого слова не существует, то ответ должен быть пустым. Если в слове допущена ошибка, "
+    "то её необходимо исправить и предоставить ответ для исправленного варианта."};
+
+}  // namespace
+
 namespace ui {
 
 using namespace std::literals;
@@ -52,6 +75,7 @@ MainWindow::MainWindow(std::weak_ptr<vocabulary::Vocabulary> vocabulary,
 
     calculateLayout();
     createUiElements();
+    createTranslationCache();
 
     onLoadVocabulary();
 
@@ -61,6 +85,16 @@ MainWindow::MainWindow(std::weak_ptr<vocabulary::Vocabulary> vocabulary,
             onAddWord();
         });
 
+    // background save of the vocabulary is finished
+    event_dispatcher_.subscribe<vocabulary::events::VocabularySavedEvent>(
+        [this](vocabulary::events::VocabularySavedEvent const& event) {
+            if (event.success) {
+                showStatus("vocabulary saved successfully");
+            } else {
+                showError("Failed to save vocabulary");
+            }
+        });
+
     auto const& stat = vocabulary_.lock()->getStatistic();
     spdlog::info("vocabulary statistics:\nwords count: {}; known words count: {}; in progress words count: {}; new words count: {};",
         stat.words_count,
@@ -318,9 +352,57 @@ void MainWindow::update(float dt)
     }
     event_dispatcher_.dispatch(events::KeyboardEvent{ .key = RKeyboard::GetKeyPressed(), .codepoints = codepoints });
 
+    // translation received so far
+    {
+        std::lock_guard lock{streamed_translation_->mutex};
+        if (std::exchange(streamed_translation_->changed, false)) {
+            input_new_word_translation_->setText(streamed_translation_->text);
+        }
+    }
+
+    // translations received since the last update
+    pollTranslation();
+
+    // background save
+    vocabulary_saver_.poll();
+    if (auto const interval = config_.getValue<int>(kAutosaveInterval); interval > 0) {
+        autosave_timer_ += dt;
+        if (autosave_timer_ >= static_cast<float>(interval)) {
+            autosave_timer_ = 0.0f;
+            if (!vocabulary_saver_.isSaving()) {
+                onSaveVocabulary();
+            }
+        }
+    }
+
+    // cancel the word translation requests in progress by key combination (Ctrl + X)
+    if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_X)) {
+        for (auto& request : translation_requests_) {
+            if (!request.expired()) {
+                spdlog::info("translation request is cancelled");
+                request.cancel();
+            }
+        }
+        translation_requests_.clear();
+    }
+
+    // export the vocabulary as a shared snapshot by key combination (Ctrl + E)
+    if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_E)) {
+        onExportSnapshot();
+    }
+
+    // translate the words of the text vocabulary by key combination (Ctrl + T)
+    if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_T)) {
+        onTranslateVocabulary();
+    }
+    pollBulkTranslation();
+
     // reload config by key combination (Ctrl + R)
     if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_R)) {
         config_.loadFromFile();
+        if (auto v = vocabulary_.lock()) {
+            v->setBatchCapacity(static_cast<size_t>(config_.getValue<int>(kLearningBatchSize)));
+        }
         calculateLayout();
         updateUiElementsLayout();
     }
@@ -351,38 +433,29 @@ void MainWindow::update(float dt)
     }
 }
 
+void MainWindow::createTranslationCache()
+{
+    auto const memory_limit{
+        static_cast<size_t>(config_.getValue<int>(kTranslationCacheMemoryLimit)) * 1024};
+    auto const file_limit{
+        static_cast<size_t>(config_.getValue<int>(kTranslationCacheFileLimit)) * 1024};
+    try {
+        translation_cache_ = std::make_unique<network::TranslationCache>(
+            config_.getValue<std::string>(kTranslationCachePath), memory_limit, file_limit);
+    } catch (const std::exception& ex) {
+        spdlog::error("{}(): {}, translations are cached in memory only", __FUNCTION__,
+                      ex.what());
+        translation_cache_ =
+            std::make_unique<network::TranslationCache>("", memory_limit, file_limit);
+    }
+}
+
 std::shared_ptr<network::Request> MainWindow::createRequest(
-    const std::string& request, network::Request::Callback callback) const
+    const std::string& request, network::Request::Callback callback,
+    network::chat_completion::DeltaCallback on_delta) const
 {
-    nlohmann::json body;
-    // body["model"] = "gemma-3-4b-it";
-    body["messages"] = nlohmann::json::array();
-    body["messages"].push_back({{"role", "system"},
-                               {"content", "Ты переводчик русского и английского языков.\n"
-                                          "Ты должен предоставлять перевод слов и словосочетаний на русский язык, "
-                                          "а также пример использования этого слова или словосочетания в предложении. "
-                                          "Ответ должен состоять из одной строки, а формат ответа должен строго "
-                                          "соответствовать следующему шаблону:\n"
-                                          "\"<русский вариант 1> ; <русский вариант 2> | "
-                                          "<Пример использования слова или словосочетания в предложении на английском языке>\"\n\n"
-                                          "Например\nслово:\n\"fine\"\nответ:\n"
-                                          "\"хорошо ; отлично | I'm fine, thank you for asking.\"\n\n"
-                                          "Если запрашиваемого слова не существует, то ответ должен быть пустым. Если в слове допущена ошибка, "
-                                          "то её необходимо исправить и предоставить ответ для исправленного варианта."}});
-    body["messages"].push_back({{"role", "user"}, {"content", request}});
-    body["temperature"] = 0.2;
-    body["stream"] = false;
-
-    auto http_request = std::make_shared<network::Request>();
-    http_request->host = config_.getValue<std::string>(kDefaultServer);
-    http_request->port = config_.getValue<std::string>(kDefaultPort);
-    http_request->target = config_.getValue<std::string>(kDefaultTarget);
-    http_request->method = config_.getValue<std::string>(kDefaultMethod);
-    http_request->headers = kDefaultHeaders;
-    http_request->body = body.empty() ? "" : body.dump();
-    http_request->callback = callback;
-
-    return http_request;
+    return network::chat_completion::makeRequest(kTranslationPrompt, request,
+                                                 std::move(callback), std::move(on_delta));
 }
 
 void MainWindow::showError(const std::string& message)
@@ -407,7 +480,7 @@ void MainWindow::onAddWordToBatch()
         if (!v->addUnknownWordToBatch()) {
             auto message = std::format("Cannot add word to batch");
             spdlog::warn(message);
-            if (v->batchSize() >= vocabulary::Vocabulary::kMaxWordsToLearn) {
+            if (v->batchSize() >= v->batchCapacity()) {
                 message = std::format("{}: {}", message, "Batch is full");
             }
             showError(message);
@@ -424,11 +497,11 @@ void MainWindow::onNextWord()
 {
     if (auto v = vocabulary_.lock()) {
         word_ = v->nextWordToLearnFromBatch();
-        if (auto word = word_.lock()) {
+        if (word_) {
             updateWordStatisticsText();
             updateVocabularyStatisticsText();
             try {
-                card_->setWord(*word);
+                card_->setWord(v->word(*word_));
             } catch (const VocabularyError& ex) {
                 showError(std::format("Failed to display word: {}", ex.what()));
             }
@@ -443,21 +516,27 @@ void MainWindow::onNextWord()
 
 void MainWindow::onKnowTheWord()
 {
-    if (!word_.expired()) {
-        word_.lock()->know();
-        onNextWord();
-    } else {
+    auto v = vocabulary_.lock();
+    if (!v) {
+        showError("Vocabulary is not available");
+    } else if (!word_ || !v->contains(*word_)) {
         showError("No word");
+    } else {
+        v->know(*word_);
+        onNextWord();
     }
 }
 
 void MainWindow::onDontKnowTheWord()
 {
-    if (!word_.expired()) {
-        word_.lock()->dontKnow();
-        onNextWord();
-    } else {
+    auto v = vocabulary_.lock();
+    if (!v) {
+        showError("Vocabulary is not available");
+    } else if (!word_ || !v->contains(*word_)) {
         showError("No word");
+    } else {
+        v->dontKnow(*word_);
+        onNextWord();
     }
 }
 
@@ -467,6 +546,9 @@ void MainWindow::onLoadVocabulary()
         try {
             // v->importFromFile(config_.kVocabularyPathMd);
             v->importFromJsonFile(config_.getValue<std::string>(kVocabularyPathJson));
+            // changes made after the last save are replayed from the journal
+            v->openJournal(config_.getValue<std::string>(kVocabularyPathJournal),
+                           config_.getValue<std::string>(kVocabularyPathJson));
             auto const msg{"vocabulary loaded successfully"};
             spdlog::info(msg);
             showStatus(msg);
@@ -474,6 +556,16 @@ void MainWindow::onLoadVocabulary()
             spdlog::error("Failed to load vocabulary: {}", ex.what());
             showError("Failed to load vocabulary");
         }
+
+        // the shared vocabulary is optional, it's only mapped, not loaded
+        auto const snapshot_path{config_.getValue<std::string>(kVocabularyPathSnapshot)};
+        try {
+            if (!snapshot_path.empty() && std::filesystem::exists(snapshot_path)) {
+                v->openSnapshot(snapshot_path);
+            }
+        } catch (const std::exception& ex) {
+            spdlog::error("Failed to open vocabulary snapshot: {}", ex.what());
+        }
     } else {
         showError("Vocabulary is not available");
     }
@@ -490,7 +582,10 @@ void MainWindow::onSaveVocabulary()
             stat.new_words_count);
 
         try {
-            v->exportToJsonFile(config_.getValue<std::string>(kVocabularyPathJson));
+            // the result is reported with VocabularySavedEvent
+            if (!vocabulary_saver_.save(v, config_.getValue<std::string>(kVocabularyPathJson))) {
+                showStatus("vocabulary is being saved");
+            }
             // v->exportToFile(config_.kVocabularyPathMd);
         } catch (const std::exception& ex) {
             spdlog::error("Failed to save vocabulary: {}", ex.what());
@@ -501,6 +596,22 @@ void MainWindow::onSaveVocabulary()
     }
 }
 
+void MainWindow::onExportSnapshot()
+{
+    if (auto v = vocabulary_.lock()) {
+        auto const path{config_.getValue<std::string>(kVocabularyPathSnapshot)};
+        try {
+            v->exportToSnapshotFile(path);
+            showStatus(std::format("vocabulary snapshot written to '{}'", path));
+        } catch (const std::exception& ex) {
+            spdlog::error("Failed to export vocabulary snapshot: {}", ex.what());
+            showError("Failed to export vocabulary snapshot");
+        }
+    } else {
+        showError("Vocabulary is not available");
+    }
+}
+
 void MainWindow::onAddWord()
 {
     if (auto voc = vocabulary_.lock()) {
@@ -510,6 +621,15 @@ void MainWindow::onAddWord()
         }
         std::string translation = input_new_word_translation_->getText();
         if (translation.empty()) {
+            // the word of the shared vocabulary is taken as is, without asking the server
+            if (auto word = voc->snapshotWord(input_new_word_->getText())) {
+                spdlog::info("Word added from the vocabulary snapshot: {}", word->toString());
+                voc->addWord(std::move(*word));
+                input_new_word_->setText("");
+                input_new_word_translation_->setText("");
+                input_new_word_example_->setText("");
+                return;
+            }
             if (auto client = http_client_.lock()) {
                 handleTranslationRequest(input_new_word_->getText());
             } else {
@@ -536,69 +656,240 @@ void MainWindow::onAddWord()
 
 void MainWindow::handleTranslationRequest(const std::string& word)
 {
-    network::Request::Callback http_response_handler = [this](const std::string& response,
-                                                              const std::string& error) {
-        if (!error.empty()) {
-            spdlog::error("HTTP error: {}", error);
+    auto const key{network::TranslationCache::makeKey(
+        word, config_.getValue<std::string>(kTranslationModel), kTranslationPrompt)};
+    auto const cached{translation_cache_->find(key)};
+    auto const stat{translation_cache_->statistic()};
+    spdlog::debug("translation cache: hits - {}, misses - {}, entries - {}", stat.hits,
+                  stat.misses, stat.entries);
+    if (cached) {
+        spdlog::info("translation of \'{}\' is found in the cache", word);
+        addTranslatedWord(*cached);
+        return;
+    }
+
+    auto const started{std::chrono::steady_clock::now()};
+    auto const elapsed_ms = [started]() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now() - started)
+            .count();
+    };
+
+    network::Request::Callback http_response_handler =
+        [stream = streamed_translation_, inbox = translation_inbox_, key, elapsed_ms](
+            const std::string& response, const std::string& error) {
+            {
+                std::lock_guard lock{stream->mutex};
+                stream->text.clear();
+                stream->changed = false;
+            }
+            spdlog::debug("translation response in {} ms", elapsed_ms());
+            std::lock_guard lock{inbox->mutex};
+            inbox->responses.push_back({key, response, error});
+        };
+    network::chat_completion::DeltaCallback on_delta;
+    if (config_.getValue<bool>(kTranslationStreaming)) {
+        on_delta = [stream = streamed_translation_, elapsed_ms,
+                    first = true](std::string_view delta) mutable {
+            if (std::exchange(first, false)) {
+                spdlog::info("time to the first token of the translation: {} ms", elapsed_ms());
+            }
+            std::lock_guard lock{stream->mutex};
+            stream->text += delta;
+            stream->changed = true;
+        };
+    }
+
+    auto request = createRequest(word, std::move(http_response_handler), std::move(on_delta));
+    if (auto client = http_client_.lock()) {
+        std::erase_if(translation_requests_, [](auto const& handle) { return handle.expired(); });
+        translation_requests_.push_back(client->sendRequest(request));
+        auto const http_stat{client->requestsStatistic()};
+        spdlog::debug("HTTP requests: connect timeouts - {}, read timeouts - {}, retries - {}, "
+                      "cancelled - {}, coalesced - {}",
+                      http_stat.connect_timeouts, http_stat.read_timeouts, http_stat.retries,
+                      http_stat.cancelled, http_stat.coalesced);
+    } else {
+        showError("HTTP client is not available");
+    }
+}
+
+void MainWindow::pollTranslation()
+{
+    std::vector<TranslationResponse> responses;
+    {
+        std::lock_guard lock{translation_inbox_->mutex};
+        responses.swap(translation_inbox_->responses);
+    }
+
+    for (auto const& response : responses) {
+        if (!response.error.empty()) {
+            spdlog::error("HTTP error: {}", response.error);
             showError("Translation request failed");
-            return;
+            continue;
         }
         try {
-            auto json_response = nlohmann::json::parse(response);
-            auto translation =
-                json_response["choices"][0]["message"]["content"].get<std::string>();
-            if (auto v = vocabulary_.lock()) {
-                v->addWord(input_new_word_->getText(),
-                           vocabulary::Translation::parse(translation));
-                spdlog::info("Word added: {} - {}", input_new_word_->getText(),
-                             translation);
-                input_new_word_->setText("");
-                input_new_word_translation_->setText("");
-                input_new_word_example_->setText("");
-            } else {
-                showError("Vocabulary is not available");
+            auto const translation{network::chat_completion::content(response.body)};
+            if (addTranslatedWord(translation)) {
+                translation_cache_->insert(response.key, translation);
             }
         } catch (const std::exception& ex) {
             spdlog::error("Error processing response: {}", ex.what());
             showError("Failed to process translation");
         }
-    };
-    auto request = createRequest(word, std::move(http_response_handler));
-    if (auto client = http_client_.lock()) {
-        client->sendRequest(request);
-    } else {
-        showError("HTTP client is not available");
+    }
+}
+
+bool MainWindow::addTranslatedWord(const std::string& translation)
+{
+    auto v = vocabulary_.lock();
+    if (!v) {
+        showError("Vocabulary is not available");
+        return false;
+    }
+
+    try {
+        v->addWord(input_new_word_->getText(), vocabulary::Translation::parse(translation));
+    } catch (const std::exception& ex) {
+        spdlog::error("Error processing translation: {}", ex.what());
+        showError("Failed to process translation");
+        return false;
+    }
+    spdlog::info("Word added: {} - {}", input_new_word_->getText(), translation);
+    input_new_word_->setText("");
+    input_new_word_translation_->setText("");
+    input_new_word_example_->setText("");
+    return true;
+}
+
+void MainWindow::onTranslateVocabulary()
+{
+    if (bulk_translator_ && !bulk_translator_->isFinished()) {
+        showStatus("words are being translated");
+        return;
+    }
+    auto v = vocabulary_.lock();
+    if (!v) {
+        showError("Vocabulary is not available");
+        return;
+    }
+
+    auto const path{config_.getValue<std::string>(kVocabularyPathMd)};
+    vocabulary::Vocabulary::ImportReport report;
+    try {
+        report = v->importFromFile(path, vocabulary::Vocabulary::kDefaultItemsDelimiter,
+                                   vocabulary::Vocabulary::kDefaultFieldsDelimiter,
+                                   vocabulary::Vocabulary::ImportMode::kMerge);
+    } catch (const std::exception& ex) {
+        spdlog::error("Failed to import '{}': {}", path, ex.what());
+        showError("Failed to import vocabulary");
+        return;
+    }
+
+    // the words translated before (one by one or in bulk) are not requested again
+    auto const model{config_.getValue<std::string>(kTranslationModel)};
+    std::vector<std::string> words;
+    std::vector<vocabulary::Word> cached_words;
+    for (auto& word : report.untranslated) {
+        auto cached{translation_cache_->find(
+            network::TranslationCache::makeKey(word, model, kTranslationPrompt))};
+        if (!cached) {
+            cached = translation_cache_->find(network::TranslationCache::makeKey(
+                word, model, network::BulkTranslator::kPrompt));
+        }
+        try {
+            if (cached) {
+                cached_words.emplace_back(word, vocabulary::Translation::parse(*cached));
+                continue;
+            }
+        } catch (const std::exception& ex) {
+            spdlog::warn("cached translation of '{}' is ignored: {}", word, ex.what());
+        }
+        words.push_back(std::move(word));
+    }
+    // journaled at once, not word by word
+    v->addWords(std::move(cached_words));
+
+    if (words.empty()) {
+        showStatus(std::format("nothing to translate, {} words added from the cache",
+                               report.untranslated.size()));
+        return;
+    }
+    showStatus(std::format("translating {} words", words.size()));
+    bulk_translator_ = std::make_unique<network::BulkTranslator>(
+        http_client_, std::move(words),
+        network::BulkTranslator::Options{
+            .batch_size = static_cast<size_t>(config_.getValue<int>(kTranslationBatchSize)),
+            .requests_in_flight =
+                static_cast<size_t>(config_.getValue<int>(kTranslationRequestsInFlight)),
+        });
+}
+
+void MainWindow::pollBulkTranslation()
+{
+    if (!bulk_translator_) {
+        return;
+    }
+    auto v = vocabulary_.lock();
+    if (!v) {
+        return;
+    }
+
+    auto const before{bulk_translator_->progress()};
+    auto const model{config_.getValue<std::string>(kTranslationModel)};
+    std::vector<vocabulary::Word> translated;
+    bulk_translator_->poll([this, &translated, &model](const std::string& word,
+                                                       vocabulary::Translation&& translation) {
+        translation_cache_->insert(
+            network::TranslationCache::makeKey(word, model, network::BulkTranslator::kPrompt),
+            translation.toString());
+        translated.emplace_back(word, std::move(translation));
+    });
+    // the words translated since the last poll are journaled at once
+    v->addWords(std::move(translated));
+
+    auto const progress{bulk_translator_->progress()};
+    if (bulk_translator_->isFinished()) {
+        showStatus(std::format("{} of {} words translated ({:.2f} words/s)",
+                               progress.translated, progress.total,
+                               progress.words_per_second));
+        updateVocabularyStatisticsText();
+        bulk_translator_.reset();
+    } else if (progress.translated + progress.failed != before.translated + before.failed) {
+        showStatus(std::format("translated {} of {} words ({:.2f} words/s)",
+                               progress.translated, progress.total,
+                               progress.words_per_second));
     }
 }
 
 void MainWindow::updateWordStatisticsText()
 {
-    if (word_.expired()) {
+    auto voc = vocabulary_.lock();
+    if (!voc) {
+        spdlog::error("Vocabulary is not available");
+        return;
+    }
+    if (!word_ || !voc->contains(*word_)) {
         return;
     }
 
     text_box_word_statistics_->clear();
 
-    auto word = word_.lock();
+    auto const& words{voc->store()};
 
     auto const message_statistics_impressions{
         std::format("Word statistics: \'know\' - {}, \'don't know\' - {}",
-                    word->knowNumber(), word->dontKnowNumber())};
+                    words.knowNumber(*word_), words.dontKnowNumber(*word_))};
     *text_box_word_statistics_ << message_statistics_impressions;
     text_box_word_statistics_->setAlignment(widgets::TextBox::Alignment::kRight);
 
-    if (auto voc = vocabulary_.lock()) {
-        auto const message_statistics_retention_rate{
-            std::format("\nRetention rate: {} (target rate - {})", word->retentionRate(), voc->targetRetentionRate())};
-        *text_box_word_statistics_ << message_statistics_retention_rate;
-        text_box_word_statistics_->setAlignment(widgets::TextBox::Alignment::kRight);
-    } 
-    else {
-        spdlog::error("Vocabulary is not available");
-    }
+    auto const message_statistics_retention_rate{
+        std::format("\nRetention rate: {} (target rate - {})", words.retentionRate(*word_), voc->targetRetentionRate())};
+    *text_box_word_statistics_ << message_statistics_retention_rate;
+    text_box_word_statistics_->setAlignment(widgets::TextBox::Alignment::kRight);
 
     spdlog::trace("word \'{}\' statistics:{}",
-                  word->word(), message_statistics_impressions);
+                  words.word(*word_), message_statistics_impressions);
 }
 
 void MainWindow::updateVocabularyStatisticsText()
@@ -608,17 +899,20 @@ void MainWindow::updateVocabularyStatisticsText()
     }
 
     auto vocabulary = vocabulary_.lock();
+    auto const stat{vocabulary->getStatistic()};
 
     auto const message_statistics{
         std::format("Vocabulary statistic:\n"
                    "words in vocabulary - {}\n"
                    "in progress - {}\n"
                    "to learn - {}\n"
-                   "have been learned - {}", 
-                   vocabulary->getStatistic().words_count,
-                   vocabulary->getStatistic().in_progress_words_count,
-                   vocabulary->getStatistic().new_words_count,
-                   vocabulary->getStatistic().known_words_count)};
+                   "have been learned - {}\n"
+                   "due for review today - {}",
+                   stat.words_count,
+                   stat.in_progress_words_count,
+                   stat.new_words_count,
+                   stat.known_words_count,
+                   vocabulary->dueTodayCount())};
 
     text_box_vocabulary_statistics_->setText(message_statistics);
     text_box_vocabulary_statistics_->setAlignment(widgets::TextBox::Alignment::kLeft);
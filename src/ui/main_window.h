@@ -3,18 +3,25 @@
 
 #include "common/config/config.h"
 #include "common/events/event_dispatcher.h"
+#include "network/bulk_translator.h"
+#include "network/chat_completion.h"
 #include "network/http/request.h"
+#include "network/http/request_handle.h"
+#include "network/translation_cache.h"
 #include "ui/tools/font_manager.h"
 #include "ui/widgets/button.h"
 #include "ui/widgets/card.h"
 #include "ui/widgets/text_input.h"
 #include "ui/widgets/text_box.h"
+#include "vocabulary/async_saver.h"
 
 #include "raylib-cpp.hpp"
 
 #include <array>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -69,14 +76,11 @@ private:
 
     Layout layout_;
 
-    static inline const std::vector<std::pair<std::string, std::string>> kDefaultHeaders{
-        {{"Content-Type", "application/json"}}};
-
     common::Config& config_;
     std::shared_ptr<ui::tools::FontManager> font_manager_;
     std::weak_ptr<vocabulary::Vocabulary> vocabulary_;
     std::weak_ptr<network::HttpClient> http_client_;
-    std::weak_ptr<vocabulary::Word> word_;
+    std::optional<vocabulary::Vocabulary::WordHandle> word_;
 
     std::unique_ptr<widgets::Button> button_add_word_to_batch_{nullptr};
     std::unique_ptr<widgets::Button> button_next_word_{nullptr};
@@ -96,17 +100,48 @@ private:
     std::string status_message_{};
 
     float status_message_timer_{};
+    float autosave_timer_{};
+
+    vocabulary::AsyncSaver vocabulary_saver_;
+    std::unique_ptr<network::TranslationCache> translation_cache_;
+    std::unique_ptr<network::BulkTranslator> bulk_translator_;
+    std::vector<network::RequestHandle> translation_requests_;  // word translation requests in flight
+
+    // translation which is being streamed by the server, it's received on the client
+    // thread and shown in the translation input by update()
+    struct StreamedTranslation {
+        std::mutex mutex;
+        std::string text;
+        bool changed{false};
+    };
+    std::shared_ptr<StreamedTranslation> streamed_translation_{
+        std::make_shared<StreamedTranslation>()};
+
+    // responses to the word translation requests, they are received on the client thread
+    // and applied to the vocabulary and the UI by update()
+    struct TranslationResponse {
+        std::string key;  // key of the translation in the cache
+        std::string body;
+        std::string error;
+    };
+    struct TranslationInbox {
+        std::mutex mutex;
+        std::vector<TranslationResponse> responses;
+    };
+    std::shared_ptr<TranslationInbox> translation_inbox_{std::make_shared<TranslationInbox>()};
 
     common::EventDispatcher& event_dispatcher_;
 
     // methods ------------------------------------------------------------
     void calculateLayout();
     void createUiElements();
+    void createTranslationCache();
     void updateUiElementsLayout();
 
     std::shared_ptr<network::Request> createRequest(
         const std::string& request,
-        network::Request::Callback callback) const;
+        network::Request::Callback callback,
+        network::chat_completion::DeltaCallback on_delta = {}) const;
 
     void showError(const std::string& message);
     void showStatus(const std::string& message);
@@ -118,8 +153,17 @@ private:
     void onDontKnowTheWord();
     void onLoadVocabulary();
     void onSaveVocabulary();
+    // writes the vocabulary as a shared read-only snapshot
+    void onExportSnapshot();
     void onAddWord();
     void handleTranslationRequest(const std::string& word);
+    // applies the word translation responses received since the last call
+    void pollTranslation();
+    // adds the word from the input with the translation received from the server
+    bool addTranslatedWord(const std::string& translation);
+    // imports the text vocabulary and translates its words which have no translation
+    void onTranslateVocabulary();
+    void pollBulkTranslation();
 
     // update statistics
     void updateWordStatisticsText();
@@ -0,0 +1,64 @@
+#include "vocabulary/async_saver.h"
+
+#include <chrono>
+
+#include "common/events/event_dispatcher.h"
+#include "spdlog/spdlog.h"
+#include "vocabulary/events/vocabulary_saved_event.h"
+#include "vocabulary/vocabulary.h"
+
+namespace vocabulary {
+
+AsyncSaver::~AsyncSaver()
+{
+    if (future_.valid()) {
+        future_.wait();
+    }
+}
+
+bool AsyncSaver::save(std::shared_ptr<Vocabulary> const& vocabulary,
+                      std::filesystem::path const& path)
+{
+    if (future_.valid()) {
+        spdlog::warn("{}(): previous save is not finished yet", __FUNCTION__);
+        return false;
+    }
+
+    std::shared_ptr<Vocabulary::Image const> copy{vocabulary->beginSnapshot()};
+    vocabulary_ = vocabulary;
+    path_ = path;
+    position_ = copy->journalPosition();
+
+    future_ = std::async(std::launch::async, [copy, path]() -> Result {
+        try {
+            copy->exportToJsonFile(path);
+            return {true, {}};
+        } catch (std::exception const& ex) {
+            return {false, ex.what()};
+        }
+    });
+    return true;
+}
+
+void AsyncSaver::poll()
+{
+    if (!future_.valid() ||
+        future_.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+        return;
+    }
+
+    auto const result{future_.get()};
+    if (auto v = vocabulary_.lock()) {
+        v->finishSnapshot(path_, position_, result.success);
+    }
+    if (result.success) {
+        spdlog::info("vocabulary saved into \'{}\'", path_.string());
+    } else {
+        spdlog::error("{}(): failed to save vocabulary: {}", __FUNCTION__, result.error);
+    }
+
+    common::EventDispatcher::instance().dispatch(
+        events::VocabularySavedEvent{{}, path_, result.success, result.error});
+}
+
+}  // namespace vocabulary
@@ -0,0 +1,56 @@
+#ifndef VOCABULARY_ASYNC_SAVER_H
+#define VOCABULARY_ASYNC_SAVER_H
+
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <string>
+
+#include "vocabulary/journal.h"
+
+namespace vocabulary {
+
+class Vocabulary;
+
+/**
+ * Saves the vocabulary into the json file on a worker thread.
+ * The vocabulary is copied on the calling thread (see Vocabulary::Image), so it can be
+ * changed while the copy is being written. The file is replaced atomically once the copy is completely written.
+ * All the methods have to be called from the same (UI) thread.
+ */
+class AsyncSaver final {
+public:
+    AsyncSaver() = default;
+    // waits for the running save
+    ~AsyncSaver();
+    AsyncSaver(AsyncSaver const& other) = delete;
+    AsyncSaver& operator=(AsyncSaver const& other) = delete;
+
+    /**
+     * @return false if the previous save is not finished yet
+     */
+    bool save(std::shared_ptr<Vocabulary> const& vocabulary, std::filesystem::path const& path);
+
+    /**
+     * Checks whether the running save is finished, if so lets the vocabulary rotate its
+     * journal and dispatches events::VocabularySavedEvent
+     */
+    void poll();
+
+    bool isSaving() const { return future_.valid(); }
+
+private:
+    struct Result {
+        bool success{};
+        std::string error;
+    };
+
+    std::future<Result> future_;
+    std::weak_ptr<Vocabulary> vocabulary_;
+    std::filesystem::path path_;
+    Journal::Position position_;
+};
+
+}  // namespace vocabulary
+
+#endif  // VOCABULARY_ASYNC_SAVER_H
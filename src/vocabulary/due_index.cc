@@ -0,0 +1,25 @@
+#include "vocabulary/due_index.h"
+
+#include <iterator>
+
+namespace vocabulary {
+
+void DueIndex::insert(Handle word, ReviewState const& review)
+{
+    if (review.reviewed()) {
+        index_.insert_or_assign({review.due, word.index}, word);
+    }
+}
+
+void DueIndex::erase(Handle word, ReviewState const& review)
+{
+    index_.erase({review.due, word.index});
+}
+
+size_t DueIndex::count(int64_t until) const
+{
+    auto const end{index_.lower_bound({until + 1, 0})};
+    return static_cast<size_t>(std::distance(index_.begin(), end));
+}
+
+}  // namespace vocabulary
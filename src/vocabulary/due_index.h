@@ -0,0 +1,56 @@
+#ifndef VOCABULARY_DUE_INDEX_H
+#define VOCABULARY_DUE_INDEX_H
+
+#include <cstdint>
+#include <map>
+#include <utility>
+
+#include "vocabulary/review_state.h"
+#include "vocabulary/word_store.h"
+
+namespace vocabulary {
+
+/**
+ * Reviewed words ordered by the time their next review is due at, so the due words
+ * are found without scanning the whole vocabulary. Only the words which have been
+ * reviewed at least once are indexed.
+ */
+class DueIndex final {
+public:
+    using Handle = WordStore::Handle;
+
+    void insert(Handle word, ReviewState const& review);
+    // must be called with the review state the word has been inserted with
+    void erase(Handle word, ReviewState const& review);
+    void clear() { index_.clear(); }
+
+    /**
+     * @param until unix time in seconds
+     * @return amount of the words which are due before or at `until`
+     */
+    size_t count(int64_t until) const;
+
+    /**
+     * Calls `visitor(Handle)` for the words which are due before or at `until`, most
+     * overdue first, until it returns false
+     */
+    template <typename Visitor>
+    void visit(int64_t until, Visitor&& visitor) const
+    {
+        for (auto it = index_.begin(); it != index_.end() && it->first.first <= until; ++it) {
+            if (!visitor(it->second)) {
+                break;
+            }
+        }
+    }
+
+    size_t size() const { return index_.size(); }
+
+private:
+    // (due time, word slot) -> word
+    std::map<std::pair<int64_t, uint32_t>, Handle> index_;
+};
+
+}  // namespace vocabulary
+
+#endif  // VOCABULARY_DUE_INDEX_H
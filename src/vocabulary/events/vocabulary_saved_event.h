@@ -0,0 +1,19 @@
+#ifndef VOCABULARY_EVENTS_VOCABULARY_SAVED_EVENT_H
+#define VOCABULARY_EVENTS_VOCABULARY_SAVED_EVENT_H
+
+#include "common/events/event.h"
+
+#include <filesystem>
+#include <string>
+
+namespace vocabulary::events {
+
+struct VocabularySavedEvent : public common::Event {
+    std::filesystem::path path;
+    bool success{};
+    std::string error;
+};
+
+} // namespace vocabulary::events
+
+#endif // VOCABULARY_EVENTS_VOCABULARY_SAVED_EVENT_H
@@ -0,0 +1,244 @@
+#include "vocabulary/journal.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include "common/exceptions/vocabulary_error.h"
+#include "spdlog/spdlog.h"
+#include "tools/binary_stream.h"
+#include "tools/file_utils.h"
+
+namespace vocabulary {
+
+Journal::Journal(std::filesystem::path const& path, uint64_t generation)
+    : path_{path}
+    , generation_{generation}
+{
+    open();
+
+    // empty file or a crash while the header was written
+    if (size_ < kHeaderSize) {
+        reset(generation);
+        return;
+    }
+
+    std::array<uint8_t, kHeaderSize> header{};
+    if (::pread(fd_, header.data(), header.size(), 0) != static_cast<ssize_t>(header.size())) {
+        ::close(fd_);
+        throw VocabularyError(fmt::format("{}(): failed to read \'{}\'", __FUNCTION__,
+                                          path.string()));
+    }
+
+    tools::binary::Reader reader{header};
+    auto const magic{reader.readBytes(kMagic.size())};
+    auto const version{reader.readU16()};
+    if (!std::equal(magic.begin(), magic.end(), kMagic.begin()) || version != kVersion) {
+        ::close(fd_);
+        throw VocabularyError(fmt::format("{}(): \'{}\' is not a vocabulary journal",
+                                          __FUNCTION__, path.string()));
+    }
+    generation_ = reader.readU64();
+}
+
+Journal::~Journal()
+{
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+size_t Journal::replay(Position const& snapshot, RecordHandler const& handler)
+{
+    if (generation_ < snapshot.generation) {
+        spdlog::info("journal \'{}\' (generation {}) is older than the snapshot "
+                     "(generation {}), dropped",
+                     path_.string(), generation_, snapshot.generation);
+        reset(snapshot.generation + 1);
+        return 0;
+    }
+
+    auto start{kHeaderSize};
+    if (generation_ == snapshot.generation) {
+        // the snapshot has been written, but the journal hasn't been rotated
+        start = std::clamp(snapshot.offset, kHeaderSize, size_);
+    }
+
+    auto const data{read(start)};
+
+    records_count_ = 0;
+    size_t offset{0};
+    while (offset < data.size()) {
+        auto const payload{tools::binary::readRecord(std::span{data}.subspan(offset))};
+        if (!payload || payload->empty()) {
+            break;
+        }
+
+        tools::binary::Reader reader{payload->subspan(1)};
+        auto const type{static_cast<RecordType>(payload->front())};
+        try {
+            handler(type, reader);
+        } catch (std::exception const& ex) {
+            spdlog::warn("{}(): journal record #{} is skipped: {}", __FUNCTION__,
+                         records_count_, ex.what());
+        }
+
+        offset += tools::binary::kRecordHeaderSize + payload->size();
+        ++records_count_;
+    }
+
+    if (offset < data.size()) {
+        spdlog::warn("{}(): torn tail of the journal \'{}\' ({} bytes) is cut off",
+                     __FUNCTION__, path_.string(), data.size() - offset);
+        truncate(start + offset);
+    }
+
+    spdlog::info("journal \'{}\' replayed, records: {}", path_.string(), records_count_);
+    return records_count_;
+}
+
+void Journal::append(RecordType type, tools::binary::Writer const& payload)
+{
+    auto const& data{payload.data()};
+
+    tools::binary::Writer body{1 + data.size()};
+    body.writeU8(static_cast<uint8_t>(type));
+    body.writeBytes(data);
+
+    tools::binary::Writer record{tools::binary::kRecordHeaderSize + body.data().size()};
+    tools::binary::writeRecord(record, body.data());
+
+    writeAll(record.data().data(), record.data().size());
+    if (::fdatasync(fd_) != 0) {
+        throw VocabularyError(fmt::format("{}(): failed to sync \'{}\': {}", __FUNCTION__,
+                                          path_.string(), std::strerror(errno)));
+    }
+    ++records_count_;
+}
+
+void Journal::rotate(size_t offset)
+{
+    auto const tail{read(std::clamp(offset, kHeaderSize, size_))};
+    auto const generation{generation_ + 1};
+
+    tools::binary::Writer header{kHeaderSize};
+    header.writeBytes({reinterpret_cast<uint8_t const*>(kMagic.data()), kMagic.size()});
+    header.writeU16(kVersion);
+    header.writeU64(generation);
+
+    try {
+        tools::file_utils::writeAtomically(path_, [&header, &tail](std::ostream& output) {
+            output.write(reinterpret_cast<char const*>(header.data().data()),
+                         static_cast<std::streamsize>(header.data().size()));
+            output.write(reinterpret_cast<char const*>(tail.data()),
+                         static_cast<std::streamsize>(tail.size()));
+        });
+    } catch (std::exception const& ex) {
+        throw VocabularyError(fmt::format("{}(): failed to rotate \'{}\': {}", __FUNCTION__,
+                                          path_.string(), ex.what()));
+    }
+
+    ::close(fd_);
+    open();
+    generation_ = generation;
+    records_count_ = 0;
+
+    spdlog::info("journal \'{}\' rotated to generation {}, {} bytes kept", path_.string(),
+                 generation_, tail.size());
+}
+
+// private ================================================
+
+void Journal::open()
+{
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw VocabularyError(fmt::format("{}(): failed to open \'{}\': {}", __FUNCTION__,
+                                          path_.string(), std::strerror(errno)));
+    }
+
+    struct stat st{};
+    if (::fstat(fd_, &st) != 0) {
+        auto const error{errno};
+        ::close(fd_);
+        fd_ = -1;
+        throw VocabularyError(fmt::format("{}(): failed to stat \'{}\': {}", __FUNCTION__,
+                                          path_.string(), std::strerror(error)));
+    }
+    size_ = static_cast<size_t>(st.st_size);
+}
+
+void Journal::reset(uint64_t generation)
+{
+    truncate(0);
+
+    tools::binary::Writer header{kHeaderSize};
+    header.writeBytes({reinterpret_cast<uint8_t const*>(kMagic.data()), kMagic.size()});
+    header.writeU16(kVersion);
+    header.writeU64(generation);
+    writeAll(header.data().data(), header.data().size());
+    if (::fsync(fd_) != 0) {
+        throw VocabularyError(fmt::format("{}(): failed to sync \'{}\': {}", __FUNCTION__,
+                                          path_.string(), std::strerror(errno)));
+    }
+
+    generation_ = generation;
+    records_count_ = 0;
+}
+
+std::vector<uint8_t> Journal::read(size_t offset) const
+{
+    std::vector<uint8_t> data;
+    data.reserve(size_ - std::min(offset, size_));
+    std::array<uint8_t, 64 * 1024> chunk{};
+    for (auto position{static_cast<off_t>(offset)};;) {
+        auto const read{::pread(fd_, chunk.data(), chunk.size(), position)};
+        if (read < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw VocabularyError(fmt::format("{}(): failed to read \'{}\': {}", __FUNCTION__,
+                                              path_.string(), std::strerror(errno)));
+        }
+        if (read == 0) {
+            break;
+        }
+        data.insert(data.end(), chunk.begin(), chunk.begin() + read);
+        position += read;
+    }
+    return data;
+}
+
+void Journal::writeAll(void const* data, size_t size)
+{
+    auto const* bytes{static_cast<uint8_t const*>(data)};
+    while (size > 0) {
+        auto const written{::write(fd_, bytes, size)};
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw VocabularyError(fmt::format("{}(): failed to write \'{}\': {}", __FUNCTION__,
+                                              path_.string(), std::strerror(errno)));
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+        size_ += static_cast<size_t>(written);
+    }
+}
+
+void Journal::truncate(size_t size)
+{
+    if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+        throw VocabularyError(fmt::format("{}(): failed to truncate \'{}\': {}", __FUNCTION__,
+                                          path_.string(), std::strerror(errno)));
+    }
+    size_ = size;
+}
+
+}  // namespace vocabulary
@@ -0,0 +1,109 @@
+#ifndef VOCABULARY_JOURNAL_H
+#define VOCABULARY_JOURNAL_H
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace tools::binary {
+class Reader;
+class Writer;
+}  // namespace tools::binary
+
+namespace vocabulary {
+
+/**
+ * Append-only log of the vocabulary changes made after the last snapshot.
+ * Every record is written with a single write() call and synced to the disk, so a crash
+ * can lose only the record which is being written. Such torn record is detected by its
+ * checksum on replay and cut off.
+ *
+ * The snapshot remembers the journal position (generation + byte offset) it includes.
+ * After the snapshot is written the journal is rotated: the records which are not in the
+ * snapshot are moved into the journal of the next generation. On replay:
+ * - journal generation == snapshot generation: records after the offset are replayed
+ *   (crash between writing the snapshot and rotating the journal);
+ * - journal generation > snapshot generation: all records are replayed;
+ * - journal generation < snapshot generation: the journal is stale and dropped.
+ *
+ * File layout (little-endian):
+ * | magic "VOCJ" | u16 version | u64 generation | records... |
+ * record: | u32 payload size | u32 payload checksum | u8 type | payload... |
+ */
+class Journal final {
+public:
+    enum class RecordType : uint8_t {
+        kAddWord = 1,
+        kRemoveWord,
+        kKnow,
+        kDontKnow,
+        kBatch,
+        kAddTranslation,
+        // kAddWord and kAddTranslation records which are synced at once (an import):
+        // | u32 count | (u8 type | record payload)... |
+        kImport,
+    };
+
+    struct Position {
+        uint64_t generation{};
+        size_t offset{};
+    };
+
+    using RecordHandler = std::function<void(RecordType, tools::binary::Reader&)>;
+
+    static constexpr std::string_view kMagic{"VOCJ"};
+    static uint16_t const kVersion{1};
+
+    /**
+     * Opens the journal or creates it with the given generation
+     * @throw VocabularyError if file can not be opened or it's not a journal
+     */
+    Journal(std::filesystem::path const& path, uint64_t generation);
+    ~Journal();
+    Journal(Journal const& other) = delete;
+    Journal& operator=(Journal const& other) = delete;
+
+    /**
+     * Calls the handler for every record which is not in the snapshot; a torn tail is cut off
+     * @param snapshot journal position the snapshot has been written at
+     * @return amount of replayed records
+     */
+    size_t replay(Position const& snapshot, RecordHandler const& handler);
+
+    /**
+     * @throw VocabularyError if the record can not be written
+     */
+    void append(RecordType type, tools::binary::Writer const& payload);
+
+    /**
+     * Starts the next generation of the journal which keeps the records after the offset
+     * @throw VocabularyError if the journal can not be rewritten
+     */
+    void rotate(size_t offset);
+
+    Position position() const { return {generation_, size_}; }
+    uint64_t generation() const { return generation_; }
+    size_t recordsCount() const { return records_count_; }
+    std::filesystem::path const& path() const { return path_; }
+
+private:
+    static constexpr size_t kHeaderSize{4 + 2 + 8};
+
+    std::filesystem::path path_;
+    int fd_{-1};
+    uint64_t generation_{0};
+    size_t size_{0};
+    size_t records_count_{0};
+
+    void open();
+    void reset(uint64_t generation);
+    std::vector<uint8_t> read(size_t offset) const;
+    void writeAll(void const* data, size_t size);
+    void truncate(size_t size);
+};
+
+}  // namespace vocabulary
+
+#endif  // VOCABULARY_JOURNAL_H
@@ -0,0 +1,233 @@
+#include "vocabulary/json_sax_reader.h"
+
+#include <limits>
+
+#include "common/exceptions/parsing_error.h"
+#include "spdlog/spdlog.h"
+
+namespace vocabulary {
+
+bool JsonSaxReader::null() { return true; }
+
+bool JsonSaxReader::boolean(bool /*val*/) { return true; }
+
+bool JsonSaxReader::number_integer(number_integer_t val) { return integer(val); }
+
+bool JsonSaxReader::number_unsigned(number_unsigned_t val)
+{
+    if (val > static_cast<number_unsigned_t>(std::numeric_limits<int64_t>::max())) {
+        throw ParsingError(fmt::format("value of \'{}\' is too big", key_));
+    }
+    return integer(static_cast<int64_t>(val));
+}
+
+bool JsonSaxReader::number_float(number_float_t val, string_t const& /*s*/)
+{
+    if (top() == Context::kReview) {
+        reviewValue(val);
+    }
+    return true;
+}
+
+bool JsonSaxReader::string(string_t& val)
+{
+    switch (top()) {
+    case Context::kWord:
+        if (key_ == "word") {
+            word_ = std::move(val);
+            word_fields_ |= kFieldWord;
+        }
+        break;
+    case Context::kVariants:
+        variants_.push_back(std::move(val));
+        break;
+    case Context::kExamples:
+        examples_.push_back(std::move(val));
+        break;
+    case Context::kBatchWords:
+        result_.batch.push_back(std::move(val));
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
+bool JsonSaxReader::binary(binary_t& /*val*/) { return true; }
+
+bool JsonSaxReader::start_object(std::size_t /*elements*/)
+{
+    if (stack_.empty()) {
+        stack_.push_back(Context::kDocument);
+        return true;
+    }
+
+    auto next{Context::kSkip};
+    if (top() == Context::kVocabulary) {
+        next = Context::kWord;
+        word_fields_ = 0;
+        word_.clear();
+        dont_know_number_ = 0;
+        know_number_ = 0;
+        variants_.clear();
+        examples_.clear();
+        review_ = {};
+    } else if (top() == Context::kWord && key_ == "review") {
+        next = Context::kReview;
+    } else if (top() == Context::kWord && key_ == "translation") {
+        next = Context::kTranslation;
+        word_fields_ |= kFieldTranslation;
+    } else if (top() == Context::kDocument && key_ == "batch_to_learn") {
+        next = Context::kBatch;
+        document_fields_ |= kFieldBatch;
+    }
+    stack_.push_back(next);
+    return true;
+}
+
+bool JsonSaxReader::key(string_t& val)
+{
+    key_ = std::move(val);
+    return true;
+}
+
+bool JsonSaxReader::end_object()
+{
+    auto const context{top()};
+    stack_.pop_back();
+
+    if (context == Context::kWord) {
+        finishWord();
+    } else if (context == Context::kBatch && !(document_fields_ & kFieldNextWord)) {
+        throw ParsingError("\'next_word_to_added_to_batch\' is missing in \'batch_to_learn\'");
+    } else if (context == Context::kDocument) {
+        if (!(document_fields_ & kFieldVocabulary)) {
+            throw ParsingError("\'vocabulary\' is missing");
+        }
+        if (!(document_fields_ & kFieldBatch)) {
+            throw ParsingError("\'batch_to_learn\' is missing");
+        }
+    }
+    return true;
+}
+
+bool JsonSaxReader::start_array(std::size_t /*elements*/)
+{
+    auto next{Context::kSkip};
+    if (top() == Context::kDocument && key_ == "vocabulary") {
+        next = Context::kVocabulary;
+        document_fields_ |= kFieldVocabulary;
+    } else if (top() == Context::kTranslation && key_ == "variants") {
+        next = Context::kVariants;
+        word_fields_ |= kFieldVariants;
+    } else if (top() == Context::kTranslation && key_ == "examples") {
+        next = Context::kExamples;
+    } else if (top() == Context::kBatch && key_ == "words") {
+        next = Context::kBatchWords;
+    }
+    stack_.push_back(next);
+    return true;
+}
+
+bool JsonSaxReader::end_array()
+{
+    stack_.pop_back();
+    return true;
+}
+
+bool JsonSaxReader::parse_error(std::size_t /*position*/, std::string const& /*last_token*/,
+                                nlohmann::json::exception const& ex)
+{
+    throw ParsingError(ex.what());
+}
+
+// private ================================================
+
+bool JsonSaxReader::integer(int64_t val)
+{
+    auto const to_int = [this](int64_t v) {
+        if (v < std::numeric_limits<int>::min() || v > std::numeric_limits<int>::max()) {
+            throw ParsingError(fmt::format("value of \'{}\' is out of range", key_));
+        }
+        return static_cast<int>(v);
+    };
+
+    if (top() == Context::kWord) {
+        if (key_ == "dont_know") {
+            dont_know_number_ = to_int(val);
+            word_fields_ |= kFieldDontKnow;
+        } else if (key_ == "know") {
+            know_number_ = to_int(val);
+            word_fields_ |= kFieldKnow;
+        }
+    } else if (top() == Context::kReview) {
+        auto const to_uint = [this](int64_t v) {
+            if (v < 0 || v > std::numeric_limits<uint32_t>::max()) {
+                throw ParsingError(fmt::format("value of \'{}\' is out of range", key_));
+            }
+            return static_cast<uint32_t>(v);
+        };
+        if (key_ == "last_review") {
+            review_.last_review = val;
+        } else if (key_ == "due") {
+            review_.due = val;
+        } else if (key_ == "interval") {
+            review_.interval = to_uint(val);
+        } else if (key_ == "repetitions") {
+            review_.repetitions = to_uint(val);
+        } else if (key_ == "lapses") {
+            review_.lapses = to_uint(val);
+        } else {
+            reviewValue(static_cast<double>(val));
+        }
+    } else if (top() == Context::kDocument && key_ == "journal_generation") {
+        if (val < 0) {
+            throw ParsingError("\'journal_generation\' can not be negative");
+        }
+        result_.journal_generation = static_cast<uint64_t>(val);
+    } else if (top() == Context::kDocument && key_ == "journal_offset") {
+        if (val < 0) {
+            throw ParsingError("\'journal_offset\' can not be negative");
+        }
+        result_.journal_offset = static_cast<size_t>(val);
+    } else if (top() == Context::kBatch && key_ == "next_word_to_added_to_batch") {
+        if (val < 0) {
+            throw ParsingError("\'next_word_to_added_to_batch\' can not be negative");
+        }
+        result_.next_word_to_added_to_batch = static_cast<size_t>(val);
+        document_fields_ |= kFieldNextWord;
+    }
+    return true;
+}
+
+void JsonSaxReader::reviewValue(double val)
+{
+    if (key_ == "ease") {
+        review_.ease = val;
+    } else if (key_ == "stability") {
+        review_.stability = val;
+    } else if (key_ == "difficulty") {
+        review_.difficulty = val;
+    }
+}
+
+void JsonSaxReader::finishWord()
+{
+    auto const mandatory{kFieldWord | kFieldTranslation | kFieldDontKnow | kFieldKnow |
+                         kFieldVariants};
+    if ((word_fields_ & mandatory) != mandatory) {
+        throw ParsingError(fmt::format("word #{} (\'{}\') misses mandatory fields",
+                                       result_.words.size(), word_));
+    }
+
+    if (variants_.empty()) {
+        throw ParsingError(fmt::format("word #{} ('{}') has no translation variants",
+                                       result_.words.size(), word_));
+    }
+
+    auto const handle{
+        result_.words.add(word_, variants_, examples_, dont_know_number_, know_number_)};
+    result_.words.setReview(handle, review_);
+}
+
+}  // namespace vocabulary
@@ -0,0 +1,105 @@
+#ifndef VOCABULARY_JSON_SAX_READER_H
+#define VOCABULARY_JSON_SAX_READER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "vocabulary/review_state.h"
+#include "vocabulary/word_store.h"
+
+#include "nlohmann/json.hpp"
+
+namespace vocabulary {
+
+/**
+ * SAX handler for the vocabulary json file. Adds the words to a WordStore directly while
+ * the input is being read, so only the word which is currently parsed is kept aside of
+ * the result. The slots of the store follow the order of the file.
+ * Expected layout is the one produced by Vocabulary::exportToJsonFile:
+ * { "batch_to_learn": { "next_word_to_added_to_batch": N, "words": [...] },
+ *   "journal_generation": N, "journal_offset": N,  (optional)
+ *   "vocabulary": [ { "word": ..., "translation": {...}, "dont_know": N, "know": N,
+ *                     "review": {...} (optional) } ] }
+ * Unknown keys are skipped.
+ * @throw ParsingError on syntax errors or if mandatory fields are missing
+ */
+class JsonSaxReader final : public nlohmann::json_sax<nlohmann::json> {
+public:
+    struct Result {
+        WordStore words;
+        size_t next_word_to_added_to_batch{};
+        std::vector<std::string> batch;
+        uint64_t journal_generation{};
+        size_t journal_offset{};
+    };
+
+    Result release() { return std::move(result_); }
+
+    bool null() override;
+    bool boolean(bool val) override;
+    bool number_integer(number_integer_t val) override;
+    bool number_unsigned(number_unsigned_t val) override;
+    bool number_float(number_float_t val, string_t const& s) override;
+    bool string(string_t& val) override;
+    bool binary(binary_t& val) override;
+
+    bool start_object(std::size_t elements) override;
+    bool key(string_t& val) override;
+    bool end_object() override;
+
+    bool start_array(std::size_t elements) override;
+    bool end_array() override;
+
+    bool parse_error(std::size_t position, std::string const& last_token,
+                     nlohmann::json::exception const& ex) override;
+
+private:
+    enum class Context {
+        kDocument,
+        kVocabulary,
+        kWord,
+        kTranslation,
+        kReview,
+        kVariants,
+        kExamples,
+        kBatch,
+        kBatchWords,
+        kSkip,
+    };
+
+    // flags of the mandatory fields seen in the current object
+    enum Field : uint8_t {
+        kFieldWord = 1 << 0,
+        kFieldTranslation = 1 << 1,
+        kFieldDontKnow = 1 << 2,
+        kFieldKnow = 1 << 3,
+        kFieldVariants = 1 << 4,
+        kFieldVocabulary = 1 << 5,
+        kFieldBatch = 1 << 6,
+        kFieldNextWord = 1 << 7,
+    };
+
+    Result result_;
+    std::vector<Context> stack_;
+    std::string key_;
+    uint8_t word_fields_{};
+    uint8_t document_fields_{};
+
+    // the word which is being parsed at the moment
+    std::string word_;
+    int dont_know_number_{};
+    int know_number_{};
+    std::vector<std::string> variants_;
+    std::vector<std::string> examples_;
+    ReviewState review_;
+
+    Context top() const { return stack_.empty() ? Context::kSkip : stack_.back(); }
+    bool integer(int64_t val);
+    void reviewValue(double val);
+    void finishWord();
+};
+
+}  // namespace vocabulary
+
+#endif  // VOCABULARY_JSON_SAX_READER_H
@@ -0,0 +1,161 @@
+#include "vocabulary/learning_batch.h"
+
+#include "spdlog/spdlog.h"
+
+namespace vocabulary {
+
+LearningBatch::LearningBatch(WordStore const& words, size_t capacity,
+                             int target_retention_rate)
+    : words_{words}
+    , capacity_{capacity}
+    , target_retention_rate_{target_retention_rate}
+{
+}
+
+void LearningBatch::reset(std::vector<Handle> const& words, size_t cursor)
+{
+    candidates_.clear();
+    positions_.clear();
+    positions_.reserve(words.size());
+    for (auto const w : words) {
+        append(w);
+    }
+    cursor_ = cursor;
+}
+
+void LearningBatch::discard()
+{
+    queue_.clear();
+    due_.clear();
+    front_turn_ = 0;
+    back_turn_ = 0;
+    candidates_.clear();
+    positions_.clear();
+}
+
+void LearningBatch::append(Handle word)
+{
+    positions_.try_emplace(word, positions_.size());
+    addCandidate(word);
+}
+
+void LearningBatch::remove(Handle word)
+{
+    erase(word);
+    if (auto const it = positions_.find(word); it != positions_.end()) {
+        candidates_.erase(it->second);
+        positions_.erase(it);
+    }
+}
+
+void LearningBatch::reviewed(Handle word)
+{
+    if (due_.contains(word)) {
+        return;  // the batch drops known words itself
+    }
+    if (auto const it = positions_.find(word); it != positions_.end()) {
+        if (isKnown(word)) {
+            candidates_.erase(it->second);
+        } else {
+            candidates_.try_emplace(it->second, word);
+        }
+    }
+}
+
+std::optional<LearningBatch::Handle> LearningBatch::nextCandidate()
+{
+    if (candidates_.empty()) {
+        return std::nullopt;
+    }
+
+    auto it{candidates_.lower_bound(cursor_)};
+    if (it == candidates_.end()) {
+        spdlog::warn("All words are known or were already in batches. Reset batch counter to 0");
+        it = candidates_.begin();
+    }
+    cursor_ = it->first + 1;
+    return it->second;
+}
+
+bool LearningBatch::pushFront(Handle word) { return push(word, --front_turn_); }
+
+bool LearningBatch::pushBack(Handle word) { return push(word, ++back_turn_); }
+
+std::optional<LearningBatch::Handle> LearningBatch::next()
+{
+    while (!queue_.empty()) {
+        auto const word{queue_.begin()->second};
+        erase(word);
+        if (!isKnown(word)) {
+            enqueue(word, ++back_turn_);
+            return word;
+        }
+        spdlog::trace("word \'{}\' is learnt and left the batch", words_.word(word));
+    }
+    return std::nullopt;
+}
+
+std::vector<LearningBatch::Handle> LearningBatch::words() const
+{
+    std::vector<Handle> result;
+    result.reserve(queue_.size());
+    for (auto const& [turn, word] : queue_) {
+        result.push_back(word);
+    }
+    return result;
+}
+
+void LearningBatch::clear()
+{
+    auto const batch{words()};
+    queue_.clear();
+    due_.clear();
+    front_turn_ = 0;
+    back_turn_ = 0;
+    for (auto const w : batch) {
+        addCandidate(w);
+    }
+}
+
+// private ================================================
+
+bool LearningBatch::isKnown(Handle word) const
+{
+    return words_.retentionRate(word) >= target_retention_rate_;
+}
+
+bool LearningBatch::push(Handle word, int64_t turn)
+{
+    if (full() || due_.contains(word)) {
+        return false;
+    }
+    enqueue(word, turn);
+    if (auto const it = positions_.find(word); it != positions_.end()) {
+        candidates_.erase(it->second);
+    }
+    return true;
+}
+
+void LearningBatch::enqueue(Handle word, int64_t turn)
+{
+    due_.emplace(word, turn);
+    queue_.emplace(turn, word);
+}
+
+void LearningBatch::erase(Handle word)
+{
+    if (auto const it = due_.find(word); it != due_.end()) {
+        queue_.erase(it->second);
+        due_.erase(it);
+    }
+}
+
+void LearningBatch::addCandidate(Handle word)
+{
+    auto const it{positions_.find(word)};
+    if (it != positions_.end() && !isKnown(word) && !due_.contains(word)) {
+        candidates_.try_emplace(it->second, word);
+    }
+}
+
+}  // namespace vocabulary
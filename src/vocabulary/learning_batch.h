@@ -0,0 +1,111 @@
+#ifndef VOCABULARY_LEARNING_BATCH_H
+#define VOCABULARY_LEARNING_BATCH_H
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "vocabulary/word_store.h"
+
+namespace vocabulary {
+
+/**
+ * Words which are being learnt (the batch) and the words which can be added to it
+ * (the candidate pool), both kept in ordered maps, so every operation is O(log n).
+ *
+ * The batch is a queue ordered by the review turn the word is due at: the word which has
+ * just been shown is due after all the others, the word which has just been added is due
+ * first. The words which have reached the target retention rate leave the batch.
+ *
+ * The candidate pool keeps the words below the target retention rate which are not in
+ * the batch, ordered by their position in the vocabulary. Candidates are taken in this
+ * order starting from the cursor, which wraps around at the end of the vocabulary.
+ *
+ * Words are referred by the handles of the vocabulary word store, their retention rate is
+ * read from it.
+ */
+class LearningBatch final {
+public:
+    using Handle = WordStore::Handle;
+
+    LearningBatch(WordStore const& words, size_t capacity, int target_retention_rate);
+
+    /**
+     * Rebuilds the candidate pool for the vocabulary words, the batch is kept
+     * @param cursor position of the first word to be checked by nextCandidate()
+     */
+    void reset(std::vector<Handle> const& words, size_t cursor);
+    // drops the batch and the candidates, the words of which are not in the store anymore
+    void discard();
+    // the word has been appended to the vocabulary
+    void append(Handle word);
+    /**
+     * The word is removed from the batch and from the candidate pool. Positions of the
+     * words are changed, so reset() has to be called once the vocabulary is updated.
+     */
+    void remove(Handle word);
+    // retention rate of the word has been changed
+    void reviewed(Handle word);
+
+    /**
+     * @return the first candidate starting from the cursor, nullopt if there are no
+     * candidates; the cursor is moved past the returned word
+     */
+    std::optional<Handle> nextCandidate();
+    size_t cursor() const { return cursor_; }
+    void setCursor(size_t cursor) { cursor_ = cursor; }
+
+    /**
+     * @return false if the batch is full or the word is already in it
+     */
+    bool pushFront(Handle word);
+    bool pushBack(Handle word);
+
+    /**
+     * Takes the first due word and moves it to the end of the queue. The words which
+     * have reached the target retention rate are dropped on the way.
+     * @return nullopt if there is no word to learn
+     */
+    std::optional<Handle> next();
+
+    // words of the batch in the order they are due
+    std::vector<Handle> words() const;
+    // moves all the batch words back to the candidate pool
+    void clear();
+
+    bool contains(Handle word) const { return due_.contains(word); }
+    size_t size() const { return queue_.size(); }
+    bool empty() const { return queue_.empty(); }
+    bool full() const { return queue_.size() >= capacity_; }
+    size_t capacity() const { return capacity_; }
+    // shrinking the capacity doesn't drop the words, it only stops adding new ones
+    void setCapacity(size_t capacity) { capacity_ = capacity; }
+
+private:
+    WordStore const& words_;
+    size_t capacity_;
+    int target_retention_rate_;
+
+    // due turn -> word; front turns are negative, back turns are positive
+    std::map<int64_t, Handle> queue_;
+    std::unordered_map<Handle, int64_t, WordStore::HandleHash> due_;
+    int64_t front_turn_{0};
+    int64_t back_turn_{0};
+
+    // position in the vocabulary -> word
+    std::map<size_t, Handle> candidates_;
+    std::unordered_map<Handle, size_t, WordStore::HandleHash> positions_;
+    size_t cursor_{0};
+
+    bool isKnown(Handle word) const;
+    bool push(Handle word, int64_t turn);
+    void enqueue(Handle word, int64_t turn);
+    void erase(Handle word);
+    void addCandidate(Handle word);
+};
+
+}  // namespace vocabulary
+
+#endif  // VOCABULARY_LEARNING_BATCH_H
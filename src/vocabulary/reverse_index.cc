@@ -0,0 +1,42 @@
+#include "vocabulary/reverse_index.h"
+
+#include <algorithm>
+
+#include "tools/string_utils.h"
+
+namespace vocabulary {
+
+void ReverseIndex::insert(Handle word, std::span<std::string_view const> variants)
+{
+    for (auto const variant : variants) {
+        auto& words{index_[tools::string_utils::normalized(variant)]};
+        if (std::ranges::find(words, word) == words.end()) {
+            words.push_back(word);
+        }
+    }
+}
+
+void ReverseIndex::erase(Handle word, std::span<std::string_view const> variants)
+{
+    for (auto const variant : variants) {
+        auto const it{index_.find(tools::string_utils::normalized(variant))};
+        if (it == index_.end()) {
+            continue;
+        }
+        std::erase(it->second, word);
+        if (it->second.empty()) {
+            index_.erase(it);
+        }
+    }
+}
+
+std::vector<ReverseIndex::Handle> ReverseIndex::find(std::string_view variant) const
+{
+    auto const it{index_.find(tools::string_utils::normalized(variant))};
+    if (it == index_.end()) {
+        return {};
+    }
+    return it->second;
+}
+
+}  // namespace vocabulary
@@ -0,0 +1,49 @@
+#ifndef VOCABULARY_REVERSE_INDEX_H
+#define VOCABULARY_REVERSE_INDEX_H
+
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "vocabulary/word_store.h"
+
+namespace vocabulary {
+
+/**
+ * Translation variant -> words it's a translation of. Variants are compared trimmed and
+ * case-insensitively (ASCII only), so "Cat " and "cat" are the same meaning.
+ */
+class ReverseIndex final {
+public:
+    using Handle = WordStore::Handle;
+
+    // adds the variants of the word which are not indexed yet
+    void insert(Handle word, std::span<std::string_view const> variants);
+    void erase(Handle word, std::span<std::string_view const> variants);
+    void clear() { index_.clear(); }
+
+    /**
+     * @return words in the order they were indexed, empty if the variant is unknown
+     */
+    std::vector<Handle> find(std::string_view variant) const;
+
+    size_t size() const { return index_.size(); }
+
+private:
+    struct Hash {
+        using is_transparent = void;
+        size_t operator()(std::string_view const variant) const
+        {
+            return std::hash<std::string_view>{}(variant);
+        }
+    };
+
+    std::unordered_map<std::string, std::vector<Handle>, Hash, std::equal_to<>> index_;
+};
+
+}  // namespace vocabulary
+
+#endif  // VOCABULARY_REVERSE_INDEX_H
@@ -0,0 +1,24 @@
+#ifndef VOCABULARY_REVIEW_STATE_H
+#define VOCABULARY_REVIEW_STATE_H
+
+#include <cstdint>
+
+namespace vocabulary {
+
+// spaced repetition state of the word, see vocabulary::Scheduler
+struct ReviewState {
+    int64_t last_review{};  // unix time in seconds, 0 - the word has never been reviewed
+    int64_t due{};          // unix time in seconds the next review is due at
+    uint32_t interval{};    // days
+    uint32_t repetitions{};  // successful reviews in a row
+    uint32_t lapses{};
+    double ease{2.5};       // SM-2 ease factor
+    double stability{};     // FSRS memory stability, days
+    double difficulty{};    // FSRS difficulty, [1, 10]
+
+    bool reviewed() const { return last_review != 0; }
+};
+
+}  // namespace vocabulary
+
+#endif  // VOCABULARY_REVIEW_STATE_H
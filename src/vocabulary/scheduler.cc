@@ -0,0 +1,151 @@
+#include "vocabulary/scheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+// default FSRS v4.5 weights
+constexpr std::array<double, 17> kFsrsWeights{
+    0.4872, 1.4003, 3.7145, 13.8206, 5.1618, 1.2298, 0.8975, 0.031, 1.6474,
+    0.1367, 1.0461, 2.1072, 0.0793, 0.3246, 1.587,  0.2272, 2.8755};
+constexpr double kFsrsDecay{-0.5};
+constexpr double kFsrsFactor{19.0 / 81.0};  // 0.9 ^ (1 / kFsrsDecay) - 1
+
+double clampDifficulty(double difficulty) { return std::clamp(difficulty, 1.0, 10.0); }
+
+}  // namespace
+
+namespace vocabulary {
+
+int64_t Scheduler::now()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+// Sm2Scheduler ===========================================
+
+ReviewState Sm2Scheduler::review(ReviewState const& state, Grade grade, int64_t now) const
+{
+    auto result{state};
+    result.last_review = now;
+
+    if (grade != Grade::kAgain && state.reviewed() && now < state.due) {
+        return result;
+    }
+
+    // SM-2 quality of the answer: 0..5
+    auto const quality{grade == Grade::kAgain  ? 1
+                       : grade == Grade::kHard ? 3
+                       : grade == Grade::kGood ? 4
+                                               : 5};
+    if (grade == Grade::kAgain) {
+        result.repetitions = 0;
+        result.interval = 1;
+        ++result.lapses;
+    } else {
+        if (result.repetitions == 0) {
+            result.interval = 1;
+        } else if (result.repetitions == 1) {
+            result.interval = 6;
+        } else {
+            result.interval =
+                static_cast<uint32_t>(std::lround(result.interval * result.ease));
+        }
+        ++result.repetitions;
+    }
+
+    result.ease = std::max(
+        1.3, result.ease + 0.1 - (5 - quality) * (0.08 + (5 - quality) * 0.02));
+    result.due = now + result.interval * kSecondsPerDay;
+    return result;
+}
+
+// FsrsScheduler ==========================================
+
+FsrsScheduler::FsrsScheduler(double desired_retention)
+    : desired_retention_{desired_retention}
+{
+}
+
+ReviewState FsrsScheduler::review(ReviewState const& state, Grade grade, int64_t now) const
+{
+    auto const& w{kFsrsWeights};
+    auto const g{static_cast<int>(grade)};
+
+    auto result{state};
+    result.last_review = now;
+
+    if (!state.reviewed() || state.stability <= 0.0) {
+        result.stability = w[g - 1];
+        result.difficulty = initialDifficulty(grade);
+    } else {
+        auto const elapsed_days{
+            std::max(0.0, static_cast<double>(now - state.last_review) / kSecondsPerDay)};
+        auto const r{retrievability(elapsed_days, state.stability)};
+        auto const s{state.stability};
+        auto const d{state.difficulty};
+
+        if (grade == Grade::kAgain) {
+            result.stability = std::min(
+                s, w[11] * std::pow(d, -w[12]) * (std::pow(s + 1.0, w[13]) - 1.0) *
+                       std::exp(w[14] * (1.0 - r)));
+        } else {
+            auto const hard_penalty{grade == Grade::kHard ? w[15] : 1.0};
+            auto const easy_bonus{grade == Grade::kEasy ? w[16] : 1.0};
+            result.stability = s * (1.0 + std::exp(w[8]) * (11.0 - d) * std::pow(s, -w[9]) *
+                                              (std::exp(w[10] * (1.0 - r)) - 1.0) *
+                                              hard_penalty * easy_bonus);
+        }
+
+        // the difficulty moves towards the initial "good" difficulty (mean reversion)
+        auto const next_difficulty{d - w[6] * (g - 3)};
+        result.difficulty = clampDifficulty(w[7] * initialDifficulty(Grade::kGood) +
+                                            (1.0 - w[7]) * next_difficulty);
+    }
+
+    if (grade == Grade::kAgain) {
+        result.repetitions = 0;
+        ++result.lapses;
+    } else {
+        ++result.repetitions;
+    }
+
+    auto const interval{result.stability / kFsrsFactor *
+                        (std::pow(desired_retention_, 1.0 / kFsrsDecay) - 1.0)};
+    result.interval = static_cast<uint32_t>(std::clamp(std::lround(interval), 1L, 36500L));
+    result.due = now + result.interval * kSecondsPerDay;
+    return result;
+}
+
+// private ================================================
+
+double FsrsScheduler::initialDifficulty(Grade grade) const
+{
+    return clampDifficulty(kFsrsWeights[4] -
+                           (static_cast<int>(grade) - 3) * kFsrsWeights[5]);
+}
+
+double FsrsScheduler::retrievability(double elapsed_days, double stability) const
+{
+    return std::pow(1.0 + kFsrsFactor * elapsed_days / stability, kFsrsDecay);
+}
+
+// ================================================================
+
+std::unique_ptr<Scheduler> makeScheduler(std::string_view name)
+{
+    if (name == Sm2Scheduler::kName) {
+        return std::make_unique<Sm2Scheduler>();
+    }
+    if (name == FsrsScheduler::kName) {
+        return std::make_unique<FsrsScheduler>();
+    }
+    return nullptr;
+}
+
+}  // namespace vocabulary
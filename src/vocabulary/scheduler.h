@@ -0,0 +1,82 @@
+#ifndef VOCABULARY_SCHEDULER_H
+#define VOCABULARY_SCHEDULER_H
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "vocabulary/review_state.h"
+
+namespace vocabulary {
+
+enum class Grade : uint8_t {
+    kAgain = 1,
+    kHard,
+    kGood,
+    kEasy,
+};
+
+/**
+ * Spaced repetition algorithm: calculates the next review time of the word
+ */
+class Scheduler {
+public:
+    static int64_t const kSecondsPerDay{24 * 60 * 60};
+
+    virtual ~Scheduler() = default;
+
+    virtual std::string_view name() const = 0;
+
+    /**
+     * @param now unix time in seconds
+     * @return the state after the review
+     */
+    virtual ReviewState review(ReviewState const& state, Grade grade, int64_t now) const = 0;
+
+    // unix time in seconds
+    static int64_t now();
+};
+
+/**
+ * SuperMemo-2: the interval is multiplied by the ease factor after every successful
+ * review. Successful reviews before the due time don't change the schedule, so the words
+ * which are repeated several times a day in the batch are not pushed months ahead.
+ */
+class Sm2Scheduler final : public Scheduler {
+public:
+    static constexpr std::string_view kName{"sm2"};
+
+    std::string_view name() const override { return kName; }
+    ReviewState review(ReviewState const& state, Grade grade, int64_t now) const override;
+};
+
+/**
+ * FSRS (Free Spaced Repetition Scheduler) v4.5 with the default weights.
+ * The interval is chosen so the predicted recall probability drops to
+ * the desired retention by the due time.
+ */
+class FsrsScheduler final : public Scheduler {
+public:
+    static constexpr std::string_view kName{"fsrs"};
+
+    explicit FsrsScheduler(double desired_retention = 0.9);
+
+    std::string_view name() const override { return kName; }
+    ReviewState review(ReviewState const& state, Grade grade, int64_t now) const override;
+
+private:
+    double desired_retention_;
+
+    double initialDifficulty(Grade grade) const;
+    // probability to recall the word after `elapsed_days` days
+    double retrievability(double elapsed_days, double stability) const;
+};
+
+/**
+ * @return nullptr if there is no scheduler with such name
+ */
+std::unique_ptr<Scheduler> makeScheduler(std::string_view name);
+
+}  // namespace vocabulary
+
+#endif  // VOCABULARY_SCHEDULER_H
@@ -0,0 +1,238 @@
+#include "vocabulary/search_index.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+
+#include "tools/string_utils.h"
+
+namespace vocabulary {
+
+void SearchIndex::add(Handle handle, std::string_view word,
+                      std::span<std::string_view const> variants)
+{
+    auto const normalized_word{tools::string_utils::normalized(word)};
+    addTerm(handle, normalized_word, false);
+
+    std::vector<std::string> added;
+    for (auto const variant : variants) {
+        auto term{tools::string_utils::normalized(variant)};
+        if (term == normalized_word || std::ranges::find(added, term) != added.end()) {
+            continue;
+        }
+        addTerm(handle, term, true);
+        added.push_back(std::move(term));
+    }
+}
+
+void SearchIndex::remove(Handle handle)
+{
+    auto const it{word_entries_.find(handle)};
+    if (it == word_entries_.end()) {
+        return;
+    }
+
+    for (auto const id : it->second) {
+        auto& entry{entries_[id]};
+        for (auto const trigram : trigrams(entry.term->first)) {
+            if (auto const postings{trigrams_.find(trigram)}; postings != trigrams_.end()) {
+                std::erase(postings->second, id);
+                if (postings->second.empty()) {
+                    trigrams_.erase(postings);
+                }
+            }
+        }
+        terms_.erase(entry.term);
+        entry = {};
+        free_entries_.push_back(id);
+    }
+    word_entries_.erase(it);
+}
+
+void SearchIndex::update(Handle handle, std::string_view word,
+                         std::span<std::string_view const> variants)
+{
+    remove(handle);
+    add(handle, word, variants);
+}
+
+void SearchIndex::clear()
+{
+    entries_.clear();
+    free_entries_.clear();
+    terms_.clear();
+    trigrams_.clear();
+    word_entries_.clear();
+}
+
+std::vector<SearchIndex::Match> SearchIndex::search(std::string_view query,
+                                                    size_t limit) const
+{
+    auto result{findPrefix(query, limit)};
+    if (result.size() >= limit) {
+        return result;
+    }
+
+    std::unordered_set<Handle, WordStore::HandleHash> found;
+    for (auto const& match : result) {
+        found.insert(match.word);
+    }
+    for (auto& match : findFuzzy(query, limit)) {
+        if (result.size() == limit) {
+            break;
+        }
+        if (found.insert(match.word).second) {
+            result.push_back(std::move(match));
+        }
+    }
+    return result;
+}
+
+std::vector<SearchIndex::Match> SearchIndex::findPrefix(std::string_view prefix,
+                                                        size_t limit) const
+{
+    std::vector<Match> result;
+    auto const normalized{tools::string_utils::normalized(prefix)};
+    if (normalized.empty()) {
+        return result;
+    }
+
+    std::unordered_set<Handle, WordStore::HandleHash> found;
+    for (auto it{terms_.lower_bound(normalized)};
+         it != terms_.end() && result.size() < limit && it->first.starts_with(normalized);
+         ++it) {
+        auto const& entry{entries_[it->second]};
+        if (found.insert(entry.word).second) {
+            result.push_back(toMatch(entry, 1.0f));
+        }
+    }
+    return result;
+}
+
+std::vector<SearchIndex::Match> SearchIndex::findFuzzy(std::string_view query,
+                                                       size_t limit) const
+{
+    std::vector<Match> result;
+    auto const query_trigrams{trigrams(tools::string_utils::normalized(query))};
+    if (query_trigrams.empty() || limit == 0) {
+        return result;
+    }
+
+    // the entries added since the previous search start with zero
+    if (shared_.size() < entries_.size()) {
+        shared_.resize(entries_.size());
+    }
+    touched_.clear();
+    for (auto const trigram : query_trigrams) {
+        auto const postings{trigrams_.find(trigram)};
+        if (postings == trigrams_.end()) {
+            continue;
+        }
+        for (auto const id : postings->second) {
+            if (shared_[id]++ == 0) {
+                touched_.push_back(id);
+            }
+        }
+    }
+
+    struct Candidate {
+        float score;
+        uint32_t id;
+    };
+    std::vector<Candidate> candidates;
+    // reserved, so nothing throws until the scratch is zeroed back
+    candidates.reserve(touched_.size());
+    for (auto const id : touched_) {
+        auto const score{2.0f * shared_[id] /
+                         static_cast<float>(query_trigrams.size() +
+                                            entries_[id].trigrams_count)};
+        shared_[id] = 0;
+        if (score >= kMinFuzzyScore) {
+            candidates.push_back({score, id});
+        }
+    }
+
+    // the best terms first, shorter ones win a tie
+    auto const better = [this](Candidate const& lhs, Candidate const& rhs) {
+        if (lhs.score != rhs.score) {
+            return lhs.score > rhs.score;
+        }
+        return entries_[lhs.id].term->first.size() < entries_[rhs.id].term->first.size();
+    };
+
+    // every word can be matched by a few terms only, so the top of this size is enough
+    auto const top{std::min(candidates.size(), limit * 4)};
+    std::partial_sort(candidates.begin(), candidates.begin() + static_cast<ptrdiff_t>(top),
+                      candidates.end(), better);
+
+    std::unordered_set<Handle, WordStore::HandleHash> found;
+    for (size_t i{0}; i < candidates.size() && result.size() < limit; ++i) {
+        if (i == top) {
+            std::sort(candidates.begin() + static_cast<ptrdiff_t>(top), candidates.end(),
+                      better);
+        }
+        auto const& entry{entries_[candidates[i].id]};
+        if (found.insert(entry.word).second) {
+            result.push_back(toMatch(entry, candidates[i].score));
+        }
+    }
+    return result;
+}
+
+// private ================================================
+
+std::vector<SearchIndex::Trigram> SearchIndex::trigrams(std::string_view term)
+{
+    std::vector<Trigram> result;
+    if (term.empty()) {
+        return result;
+    }
+
+    auto const at = [term](size_t i) -> Trigram {
+        return i == 0 || i > term.size() ? ' ' : static_cast<uint8_t>(term[i - 1]);
+    };
+    result.reserve(term.size());
+    for (size_t i{0}; i < term.size(); ++i) {
+        result.push_back(at(i) << 16 | at(i + 1) << 8 | at(i + 2));
+    }
+    std::ranges::sort(result);
+    auto const [first, last] = std::ranges::unique(result);
+    result.erase(first, last);
+    return result;
+}
+
+void SearchIndex::addTerm(Handle handle, std::string_view term, bool variant)
+{
+    if (term.empty()) {
+        return;
+    }
+
+    uint32_t id{};
+    if (free_entries_.empty()) {
+        id = static_cast<uint32_t>(entries_.size());
+        entries_.emplace_back();
+    } else {
+        id = free_entries_.back();
+        free_entries_.pop_back();
+    }
+
+    auto const term_trigrams{trigrams(term)};
+    for (auto const trigram : term_trigrams) {
+        trigrams_[trigram].push_back(id);
+    }
+
+    auto& entry{entries_[id]};
+    entry.word = handle;
+    entry.term = terms_.emplace(term, id);
+    entry.variant = variant;
+    entry.trigrams_count = static_cast<uint16_t>(
+        std::min<size_t>(term_trigrams.size(), std::numeric_limits<uint16_t>::max()));
+    word_entries_[handle].push_back(id);
+}
+
+SearchIndex::Match SearchIndex::toMatch(Entry const& entry, float score)
+{
+    return {entry.word, entry.term->first, entry.variant, score};
+}
+
+}  // namespace vocabulary
@@ -0,0 +1,89 @@
+#ifndef VOCABULARY_SEARCH_INDEX_H
+#define VOCABULARY_SEARCH_INDEX_H
+
+#include <cstdint>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "vocabulary/word_store.h"
+
+namespace vocabulary {
+
+/**
+ * Search over the words and their translation variants (the terms), meant to be queried
+ * while the user types. Terms are compared case-insensitively (ASCII only).
+ * - prefix search: ordered map of the terms, O(log n + results);
+ * - fuzzy search: trigram index, the terms sharing most trigrams with the query are
+ *   ranked by Dice coefficient, so a typo costs a few trigrams only.
+ * A word matched by several terms is reported once, with its best match.
+ * The fuzzy search reuses a scratch buffer, so the index must not be searched from
+ * several threads at once.
+ */
+class SearchIndex final {
+public:
+    using Handle = WordStore::Handle;
+
+    struct Match {
+        Handle word;
+        std::string term;  // normalized term which matched
+        bool variant{};    // term is a translation variant, not the word itself
+        float score{};     // 1 for prefix matches, Dice coefficient for fuzzy ones
+    };
+
+    // fuzzy matches with lower score are dropped
+    static constexpr float kMinFuzzyScore{0.3f};
+
+    void add(Handle handle, std::string_view word, std::span<std::string_view const> variants);
+    void remove(Handle handle);
+    // the translation of the word has been changed
+    void update(Handle handle, std::string_view word,
+                std::span<std::string_view const> variants);
+    void clear();
+
+    /**
+     * Prefix matches in the alphabetical order (so the exact match goes first), then fuzzy
+     * matches which are not found by the prefix
+     */
+    std::vector<Match> search(std::string_view query, size_t limit) const;
+    std::vector<Match> findPrefix(std::string_view prefix, size_t limit) const;
+    std::vector<Match> findFuzzy(std::string_view query, size_t limit) const;
+
+    size_t termsCount() const { return terms_.size(); }
+
+private:
+    using Terms = std::multimap<std::string, uint32_t, std::less<>>;
+    using Trigram = uint32_t;
+
+    struct Entry {
+        Handle word;  // invalid handle if the entry is free
+        Terms::iterator term;
+        bool variant{};
+        uint16_t trigrams_count{};
+    };
+
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> free_entries_;
+    Terms terms_;
+    std::unordered_map<Trigram, std::vector<uint32_t>> trigrams_;
+    std::unordered_map<Handle, std::vector<uint32_t>, WordStore::HandleHash> word_entries_;
+
+    // scratch of findFuzzy(): amount of the query trigrams every entry shares and the
+    // entries which share any. It's zeroed back by every search, so a keystroke costs
+    // the touched entries only, not the size of the index.
+    mutable std::vector<uint16_t> shared_;
+    mutable std::vector<uint32_t> touched_;
+
+    // distinct trigrams of the term padded with a space on both sides
+    static std::vector<Trigram> trigrams(std::string_view term);
+
+    void addTerm(Handle handle, std::string_view term, bool variant);
+    static Match toMatch(Entry const& entry, float score);
+};
+
+}  // namespace vocabulary
+
+#endif  // VOCABULARY_SEARCH_INDEX_H
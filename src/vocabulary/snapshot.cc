@@ -0,0 +1,264 @@
+#include "vocabulary/snapshot.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <numeric>
+
+#include "common/exceptions/vocabulary_error.h"
+#include "spdlog/spdlog.h"
+#include "tools/file_utils.h"
+
+namespace {
+
+size_t alignTo8(size_t value) { return (value + 7) & ~size_t{7}; }
+
+template <typename T>
+void appendRaw(std::vector<char>& buffer, T const* data, size_t count)
+{
+    auto const bytes{reinterpret_cast<char const*>(data)};
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T) * count);
+    buffer.resize(alignTo8(buffer.size()), '\0');
+}
+
+// the file is replaced rather than rewritten in place: the processes which have it mapped
+// keep reading the old pages instead of getting SIGBUS on a truncated mapping
+void writeFile(std::filesystem::path const& path, char const* data, size_t size)
+{
+    try {
+        tools::file_utils::writeAtomically(path, [data, size](std::ostream& output) {
+            output.write(data, static_cast<std::streamsize>(size));
+        });
+    } catch (std::exception const& ex) {
+        throw VocabularyError(fmt::format("{}(): failed to write \'{}\': {}", __FUNCTION__,
+                                          path.string(), ex.what()));
+    }
+}
+
+}  // namespace
+
+namespace vocabulary {
+
+std::string_view Snapshot::Strings::operator[](size_t index) const
+{
+    if (index >= count_) {
+        throw VocabularyError("snapshot string index is out of range");
+    }
+    return snapshot_->ref(first_ + index);
+}
+
+std::vector<std::string> Snapshot::Strings::toVector() const
+{
+    std::vector<std::string> result;
+    result.reserve(count_);
+    for (size_t i{0}; i < count_; ++i) {
+        result.emplace_back((*this)[i]);
+    }
+    return result;
+}
+
+Snapshot::Snapshot(std::filesystem::path const& path)
+    : path_{path}
+{
+    auto const fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd < 0) {
+        throw VocabularyError(fmt::format("{}(): failed to open \'{}\': {}", __FUNCTION__,
+                                          path.string(), std::strerror(errno)));
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        throw VocabularyError(fmt::format("{}(): \'{}\' is not a vocabulary snapshot",
+                                          __FUNCTION__, path.string()));
+    }
+
+    mapping_size_ = static_cast<size_t>(st.st_size);
+    auto* mapping{::mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0)};
+    ::close(fd);  // the mapping keeps its own reference to the file
+    if (mapping == MAP_FAILED) {
+        throw VocabularyError(fmt::format("{}(): failed to map \'{}\': {}", __FUNCTION__,
+                                          path.string(), std::strerror(errno)));
+    }
+    mapping_ = mapping;
+
+    auto const base{static_cast<char const*>(mapping_)};
+    auto const& header{*reinterpret_cast<Header const*>(base)};
+
+    auto const fits = [this](uint64_t offset, uint64_t size) {
+        return offset <= mapping_size_ && size <= mapping_size_ - offset;
+    };
+
+    if (std::string_view{header.magic, sizeof(header.magic)} == kMagic &&
+        header.version != kVersion) {
+        ::munmap(const_cast<void*>(mapping_), mapping_size_);
+        throw VocabularyError(fmt::format("{}(): '{}' has unsupported version {}, expected {}",
+                                          __FUNCTION__, path.string(), header.version,
+                                          kVersion));
+    }
+    if (std::string_view{header.magic, sizeof(header.magic)} != kMagic ||
+        !fits(header.entries_offset, uint64_t{header.words_count} * sizeof(Entry)) ||
+        !fits(header.sorted_index_offset, uint64_t{header.words_count} * sizeof(uint32_t)) ||
+        !fits(header.refs_offset, uint64_t{header.refs_count} * sizeof(StringRef)) ||
+        !fits(header.blob_offset, header.blob_size)) {
+        ::munmap(const_cast<void*>(mapping_), mapping_size_);
+        throw VocabularyError(fmt::format("{}(): \'{}\' is not a valid vocabulary snapshot",
+                                          __FUNCTION__, path.string()));
+    }
+
+    words_count_ = header.words_count;
+    entries_ = {reinterpret_cast<Entry const*>(base + header.entries_offset),
+                header.words_count};
+    sorted_index_ = {reinterpret_cast<uint32_t const*>(base + header.sorted_index_offset),
+                     header.words_count};
+    refs_ = {reinterpret_cast<StringRef const*>(base + header.refs_offset),
+             header.refs_count};
+    blob_ = {base + header.blob_offset, header.blob_size};
+
+    spdlog::info("vocabulary snapshot \'{}\' mapped. Words count: {}", path.string(),
+                 words_count_);
+}
+
+Snapshot::~Snapshot()
+{
+    if (mapping_) {
+        ::munmap(const_cast<void*>(mapping_), mapping_size_);
+    }
+}
+
+void Snapshot::write(std::filesystem::path const& path, WordStore const& store,
+                     std::span<WordStore::Handle const> words)
+{
+    std::vector<Entry> entries;
+    std::vector<StringRef> refs;
+    std::string blob;
+    entries.reserve(words.size());
+
+    auto const addString = [&blob](std::string_view str) {
+        auto const ref{StringRef{static_cast<uint32_t>(blob.size()),
+                                 static_cast<uint32_t>(str.size())}};
+        blob.append(str);
+        return ref;
+    };
+
+    for (auto const w : words) {
+        auto const variants{store.variants(w)};
+        auto const examples{store.examples(w)};
+        entries.push_back(Entry{.word = addString(store.word(w)),
+                                .first_ref = static_cast<uint32_t>(refs.size()),
+                                .variants_count = static_cast<uint16_t>(variants.size()),
+                                .examples_count = static_cast<uint16_t>(examples.size()),
+                                .counters = {store.dontKnowNumber(w), store.knowNumber(w)},
+                                .review = store.review(w)});
+        for (auto const v : variants) {
+            refs.push_back(addString(v));
+        }
+        for (auto const e : examples) {
+            refs.push_back(addString(e));
+        }
+    }
+
+    std::vector<uint32_t> sorted_index(entries.size());
+    std::iota(sorted_index.begin(), sorted_index.end(), 0);
+    std::stable_sort(sorted_index.begin(), sorted_index.end(),
+                     [&entries, &blob](uint32_t lhs, uint32_t rhs) {
+                         auto const& l{entries[lhs].word};
+                         auto const& r{entries[rhs].word};
+                         return std::string_view{blob}.substr(l.offset, l.size) <
+                                std::string_view{blob}.substr(r.offset, r.size);
+                     });
+
+    Header header{};
+    std::memcpy(header.magic, kMagic.data(), sizeof(header.magic));
+    header.version = kVersion;
+    header.words_count = static_cast<uint32_t>(entries.size());
+    header.refs_count = static_cast<uint32_t>(refs.size());
+
+    std::vector<char> buffer;
+    buffer.reserve(sizeof(Header) + entries.size() * (sizeof(Entry) + sizeof(uint32_t)) +
+                   refs.size() * sizeof(StringRef) + blob.size() + 32);
+    buffer.resize(alignTo8(sizeof(Header)), '\0');
+    header.entries_offset = buffer.size();
+    appendRaw(buffer, entries.data(), entries.size());
+    header.sorted_index_offset = buffer.size();
+    appendRaw(buffer, sorted_index.data(), sorted_index.size());
+    header.refs_offset = buffer.size();
+    appendRaw(buffer, refs.data(), refs.size());
+    header.blob_offset = buffer.size();
+    header.blob_size = blob.size();
+    buffer.insert(buffer.end(), blob.begin(), blob.end());
+    std::memcpy(buffer.data(), &header, sizeof(Header));
+
+    writeFile(path, buffer.data(), buffer.size());
+
+    spdlog::info("vocabulary snapshot written to the file \'{}\'", path.string());
+}
+
+std::string_view Snapshot::word(size_t index) const { return str(entry(index).word); }
+
+Snapshot::Strings Snapshot::variants(size_t index) const
+{
+    auto const& e{entry(index)};
+    return {*this, e.first_ref, e.variants_count};
+}
+
+Snapshot::Strings Snapshot::examples(size_t index) const
+{
+    auto const& e{entry(index)};
+    return {*this, e.first_ref + e.variants_count, e.examples_count};
+}
+
+std::optional<size_t> Snapshot::find(std::string_view word) const
+{
+    auto const it = std::lower_bound(
+        sorted_index_.begin(), sorted_index_.end(), word,
+        [this](uint32_t index, std::string_view w) { return this->word(index) < w; });
+    if (it == sorted_index_.end() || this->word(*it) != word) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+Word Snapshot::materialize(size_t index) const
+{
+    auto const& e{entry(index)};
+    Word result{word(index), Translation{variants(index).toVector(), examples(index).toVector()},
+                e.counters.dont_know, e.counters.know};
+    result.setReview(e.review);
+    return result;
+}
+
+// private ================================================
+
+std::string_view Snapshot::str(StringRef const& ref) const
+{
+    if (ref.offset > blob_.size() || ref.size > blob_.size() - ref.offset) {
+        throw VocabularyError(fmt::format("snapshot \'{}\' is corrupted: string is out of range",
+                                          path_.string()));
+    }
+    return blob_.substr(ref.offset, ref.size);
+}
+
+std::string_view Snapshot::ref(uint32_t index) const
+{
+    if (index >= refs_.size()) {
+        throw VocabularyError(fmt::format("snapshot \'{}\' is corrupted: reference is out of range",
+                                          path_.string()));
+    }
+    return str(refs_[index]);
+}
+
+Snapshot::Entry const& Snapshot::entry(size_t index) const
+{
+    if (index >= entries_.size()) {
+        throw VocabularyError("snapshot word index is out of range");
+    }
+    return entries_[index];
+}
+
+}  // namespace vocabulary
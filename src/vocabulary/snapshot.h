@@ -0,0 +1,137 @@
+#ifndef VOCABULARY_SNAPSHOT_H
+#define VOCABULARY_SNAPSHOT_H
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "vocabulary/review_state.h"
+#include "vocabulary/word.h"
+#include "vocabulary/word_store.h"
+
+namespace vocabulary {
+
+/**
+ * Read-only vocabulary image which is memory-mapped instead of being parsed.
+ * Words, variants and examples are served as string_views pointing straight into the
+ * mapping, so opening a snapshot costs the same for any vocabulary size and several
+ * processes share the same pages of the page cache.
+ * The "know"/"don't know" counters and the review state are read from the mapping as
+ * well, they are never changed in it: a shared word is learnt once it's copied into the
+ * vocabulary (see Vocabulary::snapshotWord()), so its reviews are journaled and saved
+ * with the vocabulary.
+ *
+ * File layout (host byte order, every table is 8-byte aligned):
+ * | Header | Entry[words_count] | u32 sorted_index[words_count] | StringRef[refs_count] | blob |
+ */
+class Snapshot final {
+public:
+    struct Counters {
+        int32_t dont_know{};
+        int32_t know{};
+    };
+
+    // lightweight range of strings of the one entry (variants or examples)
+    class Strings {
+    public:
+        Strings(Snapshot const& snapshot, uint32_t first, uint32_t count)
+            : snapshot_{&snapshot}
+            , first_{first}
+            , count_{count}
+        {}
+
+        size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+        std::string_view operator[](size_t index) const;
+        std::vector<std::string> toVector() const;
+
+    private:
+        Snapshot const* snapshot_;
+        uint32_t first_;
+        uint32_t count_;
+    };
+
+    static constexpr std::string_view kMagic{"VOCS"};
+    // version 2 has the review state in the entry
+    static uint16_t const kVersion{2};
+
+    /**
+     * @throw VocabularyError if file can not be mapped or it's not a valid snapshot
+     */
+    explicit Snapshot(std::filesystem::path const& path);
+    ~Snapshot();
+    Snapshot(Snapshot const& other) = delete;
+    Snapshot& operator=(Snapshot const& other) = delete;
+
+    /**
+     * The file is replaced atomically, so the snapshots already mapped by other processes
+     * stay valid. The entries follow the order of the handles.
+     * @throw VocabularyError if file can not be written
+     */
+    static void write(std::filesystem::path const& path, WordStore const& store,
+                      std::span<WordStore::Handle const> words);
+
+    size_t size() const { return words_count_; }
+
+    std::string_view word(size_t index) const;
+    Strings variants(size_t index) const;
+    Strings examples(size_t index) const;
+
+    // binary search over the sorted index, no allocations
+    std::optional<size_t> find(std::string_view word) const;
+
+    Counters counters(size_t index) const { return entry(index).counters; }
+    ReviewState const& review(size_t index) const { return entry(index).review; }
+
+    // creates a standalone (owning) copy of the entry with its counters and review state
+    Word materialize(size_t index) const;
+
+private:
+    struct StringRef {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    struct Entry {
+        StringRef word;
+        uint32_t first_ref;
+        uint16_t variants_count;
+        uint16_t examples_count;
+        Counters counters;
+        ReviewState review;
+    };
+
+    struct Header {
+        char magic[4];
+        uint16_t version;
+        uint16_t reserved;
+        uint32_t words_count;
+        uint32_t refs_count;
+        uint64_t entries_offset;
+        uint64_t sorted_index_offset;
+        uint64_t refs_offset;
+        uint64_t blob_offset;
+        uint64_t blob_size;
+    };
+
+    std::filesystem::path path_;
+    void const* mapping_{nullptr};
+    size_t mapping_size_{0};
+
+    uint32_t words_count_{0};
+    std::span<Entry const> entries_;
+    std::span<uint32_t const> sorted_index_;
+    std::span<StringRef const> refs_;
+    std::string_view blob_;
+
+    std::string_view str(StringRef const& ref) const;
+    std::string_view ref(uint32_t index) const;
+    Entry const& entry(size_t index) const;
+};
+
+}  // namespace vocabulary
+
+#endif  // VOCABULARY_SNAPSHOT_H
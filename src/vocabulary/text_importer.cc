@@ -0,0 +1,219 @@
+#include "vocabulary/text_importer.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <thread>
+
+#include "common/exceptions/vocabulary_error.h"
+#include "spdlog/spdlog.h"
+#include "tools/simd_scan.h"
+#include "tools/string_utils.h"
+
+namespace {
+
+// read-only mapping of the whole file, unmapped by the destructor
+class MappedFile final {
+public:
+    explicit MappedFile(std::filesystem::path const& path)
+    {
+        auto const fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (fd < 0) {
+            throw VocabularyError(fmt::format("{}(): failed to open \'{}\': {}", __FUNCTION__,
+                                              path.string(), std::strerror(errno)));
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            auto const error{errno};
+            ::close(fd);
+            throw VocabularyError(fmt::format("{}(): failed to stat \'{}\': {}", __FUNCTION__,
+                                              path.string(), std::strerror(error)));
+        }
+
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ == 0) {  // empty files can not be mapped
+            ::close(fd);
+            return;
+        }
+
+        auto* mapping{::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0)};
+        ::close(fd);  // the mapping keeps its own reference to the file
+        if (mapping == MAP_FAILED) {
+            throw VocabularyError(fmt::format("{}(): failed to map \'{}\': {}", __FUNCTION__,
+                                              path.string(), std::strerror(errno)));
+        }
+        ::madvise(mapping, size_, MADV_SEQUENTIAL);
+        mapping_ = mapping;
+    }
+
+    ~MappedFile()
+    {
+        if (mapping_) {
+            ::munmap(mapping_, size_);
+        }
+    }
+
+    MappedFile(MappedFile const& other) = delete;
+    MappedFile& operator=(MappedFile const& other) = delete;
+
+    std::string_view text() const
+    {
+        return mapping_ ? std::string_view{static_cast<char const*>(mapping_), size_}
+                        : std::string_view{};
+    }
+
+private:
+    void* mapping_{nullptr};
+    size_t size_{0};
+};
+
+}  // namespace
+
+namespace vocabulary {
+
+TextImporter::Result TextImporter::parseFile(std::filesystem::path const& path,
+                                             char item_delim, char field_delim,
+                                             size_t threads)
+{
+    MappedFile const file{path};
+    return parse(file.text(), item_delim, field_delim, threads);
+}
+
+TextImporter::Result TextImporter::parse(std::string_view text, char item_delim,
+                                         char field_delim, size_t threads)
+{
+    if (threads == 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    auto chunks{cut(text, std::max<size_t>(1, std::min(threads * kChunksPerThread,
+                                                        text.size() / kMinChunkSize)))};
+    threads = std::min(threads, chunks.size());
+
+    if (threads <= 1) {
+        for (auto& chunk : chunks) {
+            parseChunk(chunk, item_delim, field_delim);
+        }
+    } else {
+        std::atomic<size_t> next_chunk{0};
+        auto const worker = [&chunks, &next_chunk, item_delim, field_delim]() {
+            for (auto i{next_chunk++}; i < chunks.size(); i = next_chunk++) {
+                parseChunk(chunks[i], item_delim, field_delim);
+            }
+        };
+
+        std::vector<std::future<void>> workers;
+        workers.reserve(threads - 1);
+        for (size_t i{1}; i < threads; ++i) {
+            workers.push_back(std::async(std::launch::async, worker));
+        }
+        worker();
+        for (auto& w : workers) {
+            w.get();
+        }
+    }
+
+    Result result;
+    size_t words_count{0};
+    size_t untranslated_count{0};
+    for (auto const& chunk : chunks) {
+        words_count += chunk.words.size();
+        untranslated_count += chunk.untranslated.size();
+    }
+    result.words.reserve(words_count);
+    result.untranslated.reserve(untranslated_count);
+
+    size_t first_line{0};
+    for (auto& chunk : chunks) {
+        std::move(chunk.words.begin(), chunk.words.end(), std::back_inserter(result.words));
+        std::move(chunk.untranslated.begin(), chunk.untranslated.end(),
+                  std::back_inserter(result.untranslated));
+        for (auto& error : chunk.errors) {
+            error.line += first_line;
+            result.errors.push_back(std::move(error));
+        }
+        first_line += chunk.lines;
+    }
+
+    spdlog::debug("{}(): {} lines parsed by {} threads in {} chunks, {} errors, {} untranslated",
+                  __FUNCTION__, first_line, threads, chunks.size(), result.errors.size(),
+                  result.untranslated.size());
+    return result;
+}
+
+// private ================================================
+
+std::vector<TextImporter::Chunk> TextImporter::cut(std::string_view text, size_t count)
+{
+    std::vector<Chunk> chunks;
+    chunks.reserve(count);
+
+    auto const chunk_size{text.size() / count + 1};
+    while (!text.empty()) {
+        // every chunk but the last one ends right after a new line
+        auto const end{tools::simd::find(text, '\n', std::min(chunk_size, text.size()) - 1)};
+        auto const size{end == std::string_view::npos ? text.size() : end + 1};
+        chunks.emplace_back().text = text.substr(0, size);
+        text.remove_prefix(size);
+    }
+    return chunks;
+}
+
+void TextImporter::parseChunk(Chunk& chunk, char item_delim, char field_delim)
+{
+    auto text{chunk.text};
+    while (!text.empty()) {
+        auto const end{tools::simd::find(text, '\n')};
+        auto const line{text.substr(0, end)};
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+        ++chunk.lines;
+
+        if (tools::string_utils::trimmed(line).empty()) {
+            continue;
+        }
+        if (auto const word{bareWord(line, item_delim, field_delim)}; !word.empty()) {
+            chunk.untranslated.emplace_back(word);
+            continue;
+        }
+        try {
+            chunk.words.push_back(Word::parse(line, item_delim, field_delim));
+        } catch (std::exception const& ex) {
+            chunk.errors.push_back({chunk.lines, ex.what()});
+        }
+    }
+}
+
+std::string_view TextImporter::bareWord(std::string_view line, char item_delim,
+                                        char field_delim)
+{
+    using namespace tools::string_utils;
+
+    // the same slicing as Word::parse() does
+    auto const string{withoutPrefix(withoutPrefixSpacesAndTabs(line), field_delim)};
+    auto const end{string.find(field_delim)};
+    auto const word{trimmed(string.substr(0, end))};
+    if (word.empty() || word.find(item_delim) != std::string_view::npos) {
+        return {};
+    }
+
+    // "word", "word |" and "word | |" have no translation
+    if (end != std::string_view::npos) {
+        auto const empty = [field_delim](char ch) {
+            return ch == field_delim || ch == ' ' || ch == '\t' || ch == '\r';
+        };
+        if (!std::ranges::all_of(string.substr(end), empty)) {
+            return {};
+        }
+    }
+    return word;
+}
+
+}  // namespace vocabulary
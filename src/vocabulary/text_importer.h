@@ -0,0 +1,67 @@
+#ifndef VOCABULARY_TEXT_IMPORTER_H
+#define VOCABULARY_TEXT_IMPORTER_H
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "vocabulary/word.h"
+
+namespace vocabulary {
+
+/**
+ * Parses text vocabularies (one Word::parse() line per word) on a pool of worker threads.
+ * The input is cut into chunks at line boundaries, every chunk is parsed by a worker and
+ * the results are merged in the input order. Lines of any length are accepted, blank lines
+ * are skipped. A line which can not be parsed doesn't stop the import, its error is
+ * collected instead. A line which has a word, but no translation (a bare word list) is not
+ * an error, such words are collected to be translated later.
+ */
+class TextImporter final {
+public:
+    struct LineError {
+        size_t line{};  // 1-based
+        std::string message;
+    };
+
+    struct Result {
+        std::vector<Word> words;
+        std::vector<LineError> errors;
+        std::vector<std::string> untranslated;  // words of the lines without translation
+    };
+
+    /**
+     * The file is memory-mapped, so it's never copied as a whole
+     * @param threads amount of workers, hardware concurrency if 0
+     * @throw VocabularyError if file can not be opened or mapped
+     */
+    static Result parseFile(std::filesystem::path const& path, char item_delim,
+                            char field_delim, size_t threads = 0);
+
+    static Result parse(std::string_view text, char item_delim, char field_delim,
+                        size_t threads = 0);
+
+private:
+    // a chunk is never split further, so small inputs are parsed by a single worker
+    static constexpr size_t kMinChunkSize{256 * 1024};
+    // chunks per worker, so the workers which got simple chunks don't idle at the end
+    static constexpr size_t kChunksPerThread{4};
+
+    struct Chunk {
+        std::string_view text;
+        std::vector<Word> words;
+        std::vector<LineError> errors;  // line numbers are local to the chunk
+        std::vector<std::string> untranslated;
+        size_t lines{};
+    };
+
+    static std::vector<Chunk> cut(std::string_view text, size_t count);
+    static void parseChunk(Chunk& chunk, char item_delim, char field_delim);
+    // the word of the line if the line has nothing but the word, empty otherwise
+    static std::string_view bareWord(std::string_view line, char item_delim, char field_delim);
+};
+
+}  // namespace vocabulary
+
+#endif  // VOCABULARY_TEXT_IMPORTER_H
@@ -1,10 +1,12 @@
 #include "vocabulary/translation.h"
 
 #include <algorithm>
+#include <array>
 #include <numeric>  // std::accumulate
 
 #include "common/exceptions/parsing_error.h"
 #include "spdlog/spdlog.h"
+#include "tools/binary_stream.h"
 #include "tools/string_utils.h"
 
 namespace {
@@ -20,16 +22,6 @@ std::string serializeVector(std::vector<std::string> const& values, char delimit
         [delimiter](auto const& a, auto const& b) { return a + delimiter + b; });
 }
 
-void removeEmptyStrings(std::vector<std::string>& strs)
-{
-    strs.erase(std::remove_if(strs.begin(), strs.end(),
-                              [](std::string& s) {
-                                  tools::string_utils::trim(s);
-                                  return s.empty();
-                              }),
-               strs.end());
-}
-
 }  // namespace
 
 namespace vocabulary {
@@ -37,47 +29,56 @@ namespace vocabulary {
 Translation Translation::parse(std::string_view str, char const item_delim,
                                char const field_delim)
 {
+    using namespace tools::string_utils;
+
     spdlog::trace("{}(): string to be parsed: \"{}\" string size = {}", __FUNCTION__, str,
                   str.size());
 
-    auto s{std::string{str}};
-
-    tools::string_utils::trim(s);
-    tools::string_utils::removePrefix(s, field_delim);
-    tools::string_utils::removeSuffix(s, field_delim);
-
-    std::vector<std::string> parts = tools::string_utils::split(s, field_delim);
-    removeEmptyStrings(parts);
-    if (parts.empty()) {
+    // all the parts are slices of `str`, only the stored strings are allocated
+    auto const s{withoutSuffix(withoutPrefix(trimmed(str), field_delim), field_delim)};
+
+    std::array<std::string_view, 2> parts{};
+    size_t parts_count{0};
+    forEachToken(s, field_delim, [&parts, &parts_count](std::string_view part) {
+        part = trimmed(part);
+        if (!part.empty() && parts_count < parts.size()) {
+            parts[parts_count++] = part;
+        }
+    });
+    if (parts_count == 0) {
         auto const message{"parsing error: string doesn't contain anything useful"};
         // spdlog::critical(message);
         throw ParsingError(message);
     }
 
-    std::vector<std::string> variants =
-        tools::string_utils::split(parts.at(0), item_delim);
-    removeEmptyStrings(variants);
+    auto const toStrings = [item_delim](std::string_view part) {
+        std::vector<std::string> result;
+        result.reserve(static_cast<size_t>(std::ranges::count(part, item_delim)) + 1);
+        forEachToken(part, item_delim, [&result](std::string_view item) {
+            if (item = trimmed(item); !item.empty()) {
+                result.emplace_back(item);
+            }
+        });
+        return result;
+    };
 
+    auto variants{toStrings(parts[0])};
     if (variants.empty()) {
         auto const message{"parsing error: \"variants\" of the translation are empty"};
         // spdlog::critical(message);
         throw ParsingError(message);
     }
 
-    std::vector<std::string> examples{};
-    if (1 < parts.size()) {
-        examples = tools::string_utils::split(parts.at(1), item_delim);
-        removeEmptyStrings(examples);
-    }
+    auto examples{parts_count > 1 ? toStrings(parts[1]) : std::vector<std::string>{}};
 
-    return {variants, examples, item_delim, field_delim};
+    return {std::move(variants), std::move(examples), item_delim, field_delim};
 }
 
-Translation::Translation(std::vector<std::string> const& variants,
-                         std::vector<std::string> const& examples, char item_delim,
+Translation::Translation(std::vector<std::string> variants,
+                         std::vector<std::string> examples, char item_delim,
                          char field_delim)
-    : variants_{variants}
-    , examples_{examples}
+    : variants_{std::move(variants)}
+    , examples_{std::move(examples)}
 {
     if (variants_.empty()) {
         throw std::invalid_argument{"translation variants can not be empty"};
@@ -112,11 +113,32 @@ std::string Translation::examplesToString() const
     return serializeVector(examples_, item_delimiter_);
 }
 
-std::vector<std::string> Translation::variants() const { return variants_; }
+std::vector<std::string> const& Translation::variants() const { return variants_; }
 
-std::vector<std::string> Translation::examples() const { return examples_; }
+std::vector<std::string> const& Translation::examples() const { return examples_; }
 
-std::vector<uint8_t> Translation::toBin() const { return {}; }
+std::vector<uint8_t> Translation::toBin() const
+{
+    tools::binary::Writer writer;
+    toBin(writer);
+    return writer.release();
+}
+
+void Translation::toBin(tools::binary::Writer& writer) const
+{
+    writer.writeStrings(variants_);
+    writer.writeStrings(examples_);
+}
+
+Translation Translation::fromBin(tools::binary::Reader& reader)
+{
+    auto variants{reader.readStrings()};
+    if (variants.empty()) {
+        throw ParsingError("binary translation contains no variants");
+    }
+    auto examples{reader.readStrings()};
+    return {std::move(variants), std::move(examples)};
+}
 
 void Translation::addVariant(std::string_view variant)
 {
@@ -145,7 +167,7 @@ void from_json(nlohmann::json const& j, Translation& t)
     if (j.contains("examples")) {
         examples = j.at("examples");
     }
-    t = Translation(variants, examples);
+    t = Translation(std::move(variants), std::move(examples));
 }
 
 }  // namespace vocabulary
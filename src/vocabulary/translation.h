@@ -9,6 +9,11 @@
 
 #include "nlohmann/json.hpp"
 
+namespace tools::binary {
+class Reader;
+class Writer;
+}  // namespace tools::binary
+
 namespace vocabulary {
 
 class Translation {
@@ -29,8 +34,8 @@ public:
     /**
      * @throw ParsingError variants parameter is empty
      */
-    Translation(std::vector<std::string> const& variants,
-                std::vector<std::string> const& examples = {},
+    Translation(std::vector<std::string> variants,
+                std::vector<std::string> examples = {},
                 char item_delim = kDefaultItemsDelimiter,
                 char field_delim = kDefaultFieldsDelimiter);
     Translation(Translation&& other) = default;
@@ -46,9 +51,15 @@ public:
     std::string toString() const;
     std::string variantsToString() const;
     std::string examplesToString() const;
-    std::vector<std::string> variants() const;
-    std::vector<std::string> examples() const;
+    std::vector<std::string> const& variants() const;
+    std::vector<std::string> const& examples() const;
     std::vector<uint8_t> toBin() const;
+    void toBin(tools::binary::Writer& writer) const;
+
+    /**
+     * @throw ParsingError if data is truncated or variants are empty
+     */
+    static Translation fromBin(tools::binary::Reader& reader);
 
     void addVariant(std::string_view variant);
     void addExample(std::string_view example);
@@ -1,45 +1,248 @@
 #include "vocabulary.h"
 
 #include "common/config/config.h"
+#include "common/exceptions/parsing_error.h"
+#include "tools/binary_stream.h"
+#include "tools/file_utils.h"
+#include "tools/json_writer.h"
 #include "tools/random_number.h"
+#include "vocabulary/json_sax_reader.h"
 
-#include <array>
+#include <algorithm>
+#include <cassert>
+#include <ctime>
 #include <format>
 #include <fstream>
 #include <iostream>
 #include <iterator>
 #include <numeric>
-#include <set>
+#include <ranges>
 #include <stdexcept>
+#include <unordered_set>
 
 #include "spdlog/spdlog.h"
 
 const auto kRetentionRateForKnownWord{common::Config::instance().getValue<int>(common::ConfigId::kRetentionRateForKnownWord)};
 
+namespace {
+
+void writeReview(tools::binary::Writer& writer, vocabulary::ReviewState const& review)
+{
+    writer.writeI64(review.last_review);
+    writer.writeI64(review.due);
+    writer.writeU32(review.interval);
+    writer.writeU32(review.repetitions);
+    writer.writeU32(review.lapses);
+    writer.writeF64(review.ease);
+    writer.writeF64(review.stability);
+    writer.writeF64(review.difficulty);
+}
+
+vocabulary::ReviewState readReview(tools::binary::Reader& reader)
+{
+    vocabulary::ReviewState review;
+    review.last_review = reader.readI64();
+    review.due = reader.readI64();
+    review.interval = reader.readU32();
+    review.repetitions = reader.readU32();
+    review.lapses = reader.readU32();
+    review.ease = reader.readF64();
+    review.stability = reader.readF64();
+    review.difficulty = reader.readF64();
+    return review;
+}
+
+// keys are written in alphabetical order, as nlohmann::json does
+void writeBatchJson(tools::json::StreamWriter& writer, size_t cursor,
+                    std::vector<std::string_view> const& words,
+                    vocabulary::Journal::Position const& position)
+{
+    writer.key("batch_to_learn").beginObject();
+    writer.key("next_word_to_added_to_batch").value(cursor);
+    writer.key("words").beginArray();
+    for (auto const word : words) {
+        writer.value(word);
+    }
+    writer.endArray();
+    writer.endObject();
+
+    writer.key("journal_generation").value(position.generation);
+    writer.key("journal_offset").value(position.offset);
+}
+
+void writeWordJson(tools::json::StreamWriter& writer, vocabulary::WordStore const& words,
+                   vocabulary::WordStore::Handle word)
+{
+    auto const& review{words.review(word)};
+    writer.beginObject();
+    writer.key("dont_know").value(words.dontKnowNumber(word));
+    writer.key("know").value(words.knowNumber(word));
+    if (review.reviewed()) {
+        writer.key("review").beginObject();
+        writer.key("difficulty").value(review.difficulty);
+        writer.key("due").value(review.due);
+        writer.key("ease").value(review.ease);
+        writer.key("interval").value(review.interval);
+        writer.key("lapses").value(review.lapses);
+        writer.key("last_review").value(review.last_review);
+        writer.key("repetitions").value(review.repetitions);
+        writer.key("stability").value(review.stability);
+        writer.endObject();
+    }
+    writer.key("translation").beginObject();
+    writer.key("examples").value(words.examples(word));
+    writer.key("variants").value(words.variants(word));
+    writer.endObject();
+    writer.key("word").value(words.word(word));
+    writer.endObject();
+}
+
+// the same layout as Word::toBin() has
+void writeWordBin(tools::binary::Writer& writer, vocabulary::WordStore const& words,
+                  vocabulary::WordStore::Handle word)
+{
+    writer.writeString(words.word(word));
+    writer.writeI32(words.dontKnowNumber(word));
+    writer.writeI32(words.knowNumber(word));
+    writer.writeStrings(words.variants(word));
+    writer.writeStrings(words.examples(word));
+}
+
+}  // namespace
+
 namespace vocabulary {
 
-Translation const& Vocabulary::translate(std::string_view const word)
+void Vocabulary::Image::exportToJsonFile(std::filesystem::path const& path, int indent) const
+{
+    try {
+        tools::file_utils::writeAtomically(
+            path, [this, indent](std::ostream& output) { writeJson(output, indent); });
+    } catch (std::exception const& ex) {
+        auto const msg{fmt::format("{}(): failed to write \'{}\': {}", __FUNCTION__,
+                                   path.string(), ex.what())};
+        throw VocabularyError(msg);
+    }
+}
+
+void Vocabulary::Image::writeJson(std::ostream& output, int indent) const
+{
+    tools::json::StreamWriter writer{output, indent};
+    writer.beginObject();
+
+    writeBatchJson(writer, batch_cursor_,
+                   std::vector<std::string_view>(batch_.begin(), batch_.end()),
+                   journal_position_);
+
+    writer.key("vocabulary").beginArray();
+    // nothing is removed from the image, so the slot order is the vocabulary order
+    words_.forEach(
+        [this, &writer](WordStore::Handle handle) { writeWordJson(writer, words_, handle); });
+    writer.endArray();
+
+    writer.endObject();
+}
+
+Vocabulary::Vocabulary()
+    : learning_batch_{store_,
+                      static_cast<size_t>(common::Config::instance().getValue<int>(
+                          common::ConfigId::kLearningBatchSize)),
+                      kRetentionRateForKnownWord}
+{
+    auto const name{
+        common::Config::instance().getValue<std::string>(common::ConfigId::kScheduler)};
+    scheduler_ = makeScheduler(name);
+    if (!scheduler_) {
+        spdlog::warn("{}(): unknown scheduler \'{}\', \'{}\' is used", __FUNCTION__, name,
+                     Sm2Scheduler::kName);
+        scheduler_ = std::make_unique<Sm2Scheduler>();
+    }
+}
+
+Vocabulary::~Vocabulary() = default;
+
+std::optional<Vocabulary::WordHandle> Vocabulary::find(std::string_view const word) const
+{
+    return store_.find(word);
+}
+
+Translation Vocabulary::translate(std::string_view const word) const
 {
-    auto w = findWord(word).lock();
+    auto const w{find(word)};
     if (!w) {
         auto const msg{fmt::format("{}(): word \'{}\' is not found in the vocabulary",
-                                   __FUNCTION__, w->word())};
+                                   __FUNCTION__, word)};
         throw VocabularyError(msg);
     }
-    return w->translation();
+    auto const variants{store_.variants(*w)};
+    auto const examples{store_.examples(*w)};
+    return {{variants.begin(), variants.end()}, {examples.begin(), examples.end()}};
 }
 
-Vocabulary::Statistic Vocabulary::getStatistic() const
+Word Vocabulary::word(WordHandle word) const
+{
+    if (!store_.valid(word)) {
+        throw VocabularyError(
+            fmt::format("{}(): word has been removed from the vocabulary", __FUNCTION__));
+    }
+    return store_.materialize(word);
+}
+
+std::vector<SearchIndex::Match> Vocabulary::search(std::string_view const query, size_t limit)
+{
+    if (!search_index_built_) {
+        for (auto const w : words_) {
+            search_index_.add(w, store_.word(w), store_.variants(w));
+        }
+        search_index_built_ = true;
+        spdlog::debug("{}(): search index built, terms: {}", __FUNCTION__,
+                      search_index_.termsCount());
+    }
+    return search_index_.search(query, limit);
+}
+
+std::vector<Vocabulary::WordHandle> Vocabulary::wordsByTranslation(
+    std::string_view const variant)
 {
-    auto result{Statistic{.words_count = words_.size()}};
+    return reverseIndex().find(variant);
+}
+
+std::vector<Vocabulary::WordHandle> Vocabulary::synonyms(std::string_view const word)
+{
+    auto const w{find(word)};
+    if (!w) {
+        throw VocabularyError(fmt::format("{}(): word \'{}\' is not found in the vocabulary",
+                                          __FUNCTION__, word));
+    }
 
-    for (auto const& w : words_) {
-        if (w->retentionRate() > kRetentionRateForKnownWord) {
-            ++result.known_words_count;
+    std::vector<WordHandle> result;
+    std::unordered_set<WordHandle, WordStore::HandleHash> found{*w};
+    for (auto const variant : store_.variants(*w)) {
+        for (auto const other : reverseIndex().find(variant)) {
+            if (found.insert(other).second) {
+                result.push_back(other);
+            }
         }
     }
-    result.in_progress_words_count = batch_.size();
+    return result;
+}
+
+Vocabulary::Statistic Vocabulary::getStatistic() const
+{
+    auto result{Statistic{.words_count = words_.size(),
+                          .known_words_count = known_words_count_,
+                          .in_progress_words_count = learning_batch_.size()}};
     result.new_words_count = result.words_count - result.known_words_count - result.in_progress_words_count;
+
+#ifdef VOCABULARY_CHECK_COUNTERS
+    // the counters are updated incrementally, make sure none of the changes is missed
+    auto const known_words_count{store_.countKnown(kRetentionRateForKnownWord)};
+    if (known_words_count != known_words_count_) {
+        spdlog::error("{}(): known words counter is {}, but {} words are known",
+                      __FUNCTION__, known_words_count_, known_words_count);
+        assert(false);
+    }
+#endif
+
     return result;
 }
 
@@ -51,41 +254,178 @@ void Vocabulary::addWord(std::string_view const word, Translation&& translation)
 void Vocabulary::addWord(Word&& word)
 {
     spdlog::trace("{}(): new word added to vocabulary: {}", __FUNCTION__, word.toString());
-    words_.push_back(std::make_shared<Word>(std::move(word)));
+    words_.push_back(store_.add(word));
+    addToIndex(words_.back());
+    learning_batch_.append(words_.back());
+
+    if (journal_) {
+        tools::binary::Writer payload;
+        word.toBin(payload);
+        journal(Journal::RecordType::kAddWord, payload);
+    }
 }
 
-void Vocabulary::importFromFile(std::filesystem::path const& path, char item_delim,
-                                char field_delim)
+void Vocabulary::addWords(std::vector<Word>&& words)
 {
-    std::ifstream inputFile(path);
-    if (!inputFile) {
-        auto const msg{
-            fmt::format("{}(): failed to open \'{}\'", __FUNCTION__, path.string())};
-        throw VocabularyError(msg);
+    if (words.empty()) {
+        return;
+    }
+    words_.reserve(words_.size() + words.size());
+    suspendJournal();
+    for (auto& word : words) {
+        addWord(std::move(word));
+    }
+    resumeJournal();
+}
+
+bool Vocabulary::removeWord(std::string_view const word)
+{
+    if (!store_.find(word)) {
+        spdlog::warn("{}(): word \'{}\' is not found in the vocabulary", __FUNCTION__, word);
+        return false;
+    }
+
+    auto const isRemoved = [this, word](WordHandle w) { return store_.word(w) == word; };
+    auto const cursor{learning_batch_.cursor()};
+    auto const removed_before_cursor{static_cast<size_t>(std::count_if(
+        words_.begin(), words_.begin() + std::min(cursor, words_.size()), isRemoved))};
+
+    for (auto const w : words_) {
+        if (isRemoved(w)) {
+            learning_batch_.remove(w);
+            due_index_.erase(w, store_.review(w));
+            search_index_.remove(w);
+            if (reverse_index_built_) {
+                reverse_index_.erase(w, store_.variants(w));
+            }
+            known_words_count_ -= isKnown(w) ? 1 : 0;
+        }
+    }
+    // `word` can be a view of the store text, which stays until the store is compacted
+    std::erase_if(words_, [this, &isRemoved](WordHandle w) {
+        return isRemoved(w) && store_.remove(w);
+    });
+    learning_batch_.reset(words_, cursor - removed_before_cursor);
+
+    spdlog::trace("{}(): word \'{}\' removed from vocabulary", __FUNCTION__, word);
+
+    journalWord(Journal::RecordType::kRemoveWord, word);
+
+    // the text of the removed words is released once it's the most of the store
+    if (store_.garbageBytes() > store_.memoryUsage() / 2) {
+        store_.compact();
+    }
+    return true;
+}
+
+void Vocabulary::know(WordHandle word)
+{
+    if (store_.valid(word)) {
+        auto const time{Scheduler::now()};
+        review(word, Grade::kGood, time);
+        journalReview(Journal::RecordType::kKnow, store_.word(word), time);
+    }
+}
+
+void Vocabulary::dontKnow(WordHandle word)
+{
+    if (store_.valid(word)) {
+        auto const time{Scheduler::now()};
+        review(word, Grade::kAgain, time);
+        journalReview(Journal::RecordType::kDontKnow, store_.word(word), time);
     }
+}
+
+void Vocabulary::setScheduler(std::unique_ptr<Scheduler> scheduler)
+{
+    if (scheduler) {
+        scheduler_ = std::move(scheduler);
+    }
+}
 
+size_t Vocabulary::dueTodayCount() const
+{
+    auto const now{static_cast<std::time_t>(Scheduler::now())};
+    std::tm local{};
+    localtime_r(&now, &local);
+    local.tm_hour = 23;
+    local.tm_min = 59;
+    local.tm_sec = 59;
+    return dueCount(static_cast<int64_t>(std::mktime(&local)));
+}
+
+Vocabulary::ImportReport Vocabulary::importFromFile(std::filesystem::path const& path,
+                                                    char item_delim, char field_delim,
+                                                    ImportMode mode)
+{
+    auto const threads{std::max(
+        0, common::Config::instance().getValue<int>(common::ConfigId::kImportThreads))};
+    auto result{TextImporter::parseFile(path, item_delim, field_delim,
+                                        static_cast<size_t>(threads))};
+
+    ImportReport report;
+    words_.reserve(words_.size() + result.words.size());
+    // a synced journal record per word (and a snapshot rewrite every
+    // kJournalCompactionThreshold of them) would make a large import quadratic
+    suspendJournal();
     try {
-        for (std::array<char, 1024> a{'\0'}; inputFile.getline(&a[0], a.size());) {
-            words_.push_back(
-                std::make_shared<Word>(
-                    Word::parse(a.data(), item_delim, field_delim)
-            ));
+        for (auto& word : result.words) {
+            if (mode == ImportMode::kAppend) {
+                addWord(std::move(word));
+                ++report.added;
+                continue;
+            }
+            switch (mergeWord(std::move(word))) {
+            case MergeResult::kAdded:
+                ++report.added;
+                break;
+            case MergeResult::kMerged:
+                ++report.merged;
+                break;
+            case MergeResult::kSkipped:
+                ++report.skipped;
+                break;
+            }
         }
-    } catch (std::exception const& e) {
-        spdlog::error("{}", e.what());
+    } catch (...) {
+        resumeJournal();
         throw;
     }
+    resumeJournal();
+    report.errors = std::move(result.errors);
 
-    spdlog::info("vocabulary \'{}\' successfully imported. Words count: {}",
-        path.string(), words_.size());
+    // reserved, so the views of the seen words stay valid
+    report.untranslated.reserve(result.untranslated.size());
+    std::unordered_set<std::string_view> seen;
+    for (auto& word : result.untranslated) {
+        if (!store_.find(word) && !seen.contains(word)) {
+            seen.insert(report.untranslated.emplace_back(std::move(word)));
+        }
+    }
+
+    if (!report.errors.empty()) {
+        // a broken dump can have millions of them, so only the first ones are logged
+        auto constexpr kLoggedErrors{10UZ};
+        for (auto const& error : report.errors | std::views::take(kLoggedErrors)) {
+            spdlog::error("\'{}\':{}: {}", path.string(), error.line, error.message);
+        }
+        spdlog::warn("{}(): {} lines of \'{}\' are skipped", __FUNCTION__,
+                     report.errors.size(), path.string());
+    }
+
+    spdlog::info("vocabulary \'{}\' successfully imported. Added: {}, merged: {}, "
+                 "unchanged: {}, untranslated: {}. Words count: {}",
+                 path.string(), report.added, report.merged, report.skipped,
+                 report.untranslated.size(), words_.size());
+    return report;
 }
 
 void Vocabulary::exportToFile(std::filesystem::path const& path)
 {
     std::ofstream outputFile(path);
     try {
-        for (auto const& word : words_) {
-            outputFile << word->toString() << '\n';
+        for (auto const word : words_) {
+            outputFile << store_.materialize(word).toString() << '\n';
         }
     } catch (std::exception const& e) {
         spdlog::error("{}", e.what());
@@ -103,17 +443,21 @@ void Vocabulary::importFromJsonFile(std::filesystem::path const& path)
         throw VocabularyError(msg);
     }
 
+    closeJournal();
+
     try {
-        auto j = nlohmann::json::parse(inputFile);
-
-        words_ = j.at("vocabulary");
-        next_word_to_added_to_batch_ =
-            j.at("batch_to_learn").at("next_word_to_added_to_batch").get<size_t>();
-        const auto& words_to_learn_json = j.at("batch_to_learn").at("words");
-        batch_.clear();
-        for (auto const& w : words_to_learn_json) {
-            addWordToBatch(std::string(w));
-        }
+        // words are built while the file is read, no json DOM is created
+        JsonSaxReader reader;
+        nlohmann::json::sax_parse(inputFile, &reader);
+        auto result{reader.release()};
+
+        std::vector<WordHandle> words;
+        words.reserve(result.words.size());
+        result.words.forEach([&words](WordHandle w) { words.push_back(w); });
+        replaceWords(std::move(result.words), std::move(words));
+        journal_generation_ = result.journal_generation;
+        journal_offset_ = result.journal_offset;
+        setBatch(result.next_word_to_added_to_batch, result.batch);
     }
     catch (std::exception const& ex) {
         auto const msg{
@@ -123,87 +467,357 @@ void Vocabulary::importFromJsonFile(std::filesystem::path const& path)
 }
 
 
-void Vocabulary::exportToJsonFile(std::filesystem::path const& path) const
+void Vocabulary::exportToJsonFile(std::filesystem::path const& path, int indent) const
 {
-    std::ofstream outputFile(path);
+    try {
+        tools::file_utils::writeAtomically(
+            path, [this, indent](std::ostream& output) { writeJson(output, indent); });
+    } catch (std::exception const& ex) {
+        auto const msg{fmt::format("{}(): failed to write \'{}\': {}", __FUNCTION__,
+                                   path.string(), ex.what())};
+        throw VocabularyError(msg);
+    }
+}
 
-    if (!outputFile) {
+void Vocabulary::importFromBinFile(std::filesystem::path const& path)
+{
+    std::ifstream inputFile(path, std::ios::binary | std::ios::ate);
+    if (!inputFile) {
         auto const msg{
             fmt::format("{}(): failed to open \'{}\'", __FUNCTION__, path.string())};
         throw VocabularyError(msg);
     }
+
+    std::vector<uint8_t> data(static_cast<size_t>(inputFile.tellg()));
+    inputFile.seekg(0);
+    if (!inputFile.read(reinterpret_cast<char*>(data.data()), data.size())) {
+        auto const msg{
+            fmt::format("{}(): failed to read \'{}\'", __FUNCTION__, path.string())};
+        throw VocabularyError(msg);
+    }
+
+    closeJournal();
+
     try {
-        nlohmann::json j;
-        j["vocabulary"] = words_;
-        j["batch_to_learn"]["words"] = nlohmann::json::array();
-        for (auto const& word : batch_) {
-            j["batch_to_learn"]["words"].push_back(word.lock()->word());
+        tools::binary::Reader reader{data};
+
+        auto const magic{reader.readBytes(kBinMagic.size())};
+        if (!std::equal(magic.begin(), magic.end(), kBinMagic.begin())) {
+            throw ParsingError("wrong magic, file is not a binary vocabulary");
+        }
+        auto const version{reader.readU16()};
+        if (version == 0 || version > kBinVersion) {
+            throw ParsingError(fmt::format("unsupported binary vocabulary version {}, expected {}",
+                                           version, kBinVersion));
         }
-        j["batch_to_learn"]["next_word_to_added_to_batch"] = next_word_to_added_to_batch_;
-        outputFile << j.dump(4);
 
-    } catch (std::exception const& e) {
-        spdlog::error("{}", e.what());
+        auto const words_count{reader.readU64()};
+        WordStore store;
+        std::vector<WordHandle> words;
+        words.reserve(std::min<size_t>(words_count, reader.left()));
+        for (uint64_t i{0}; i < words_count; ++i) {
+            words.push_back(store.add(Word::fromBin(reader)));
+            if (version >= 2) {
+                store.setReview(words.back(), readReview(reader));
+            }
+        }
+        replaceWords(std::move(store), std::move(words));
+
+        auto const cursor{reader.readU64()};
+        std::vector<std::string> batch(reader.readU32());
+        for (auto& w : batch) {
+            w = reader.readString();
+        }
+        setBatch(cursor, batch);
+    }
+    catch (std::exception const& ex) {
+        auto const msg{
+            fmt::format("{}(): failed to parse binary file \'{}\': {}", __FUNCTION__, path.string(), ex.what())};
+        throw VocabularyError(msg);
+    }
+
+    spdlog::info("vocabulary \'{}\' successfully imported. Words count: {}",
+        path.string(), words_.size());
+}
+
+void Vocabulary::exportToBinFile(std::filesystem::path const& path) const
+{
+    std::ofstream outputFile(path, std::ios::binary);
+    if (!outputFile) {
+        auto const msg{
+            fmt::format("{}(): failed to open \'{}\'", __FUNCTION__, path.string())};
+        throw VocabularyError(msg);
+    }
+
+    tools::binary::Writer writer;
+    writer.writeBytes({reinterpret_cast<uint8_t const*>(kBinMagic.data()), kBinMagic.size()});
+    writer.writeU16(kBinVersion);
+    writer.writeU64(words_.size());
+    for (auto const word : words_) {
+        writeWordBin(writer, store_, word);
+        writeReview(writer, store_.review(word));
+    }
+    writer.writeU64(learning_batch_.cursor());
+
+    auto const batch{learning_batch_.words()};
+    writer.writeU32(static_cast<uint32_t>(batch.size()));
+    for (auto const word : batch) {
+        writer.writeString(store_.word(word));
+    }
+
+    auto const& data{writer.data()};
+    if (!outputFile.write(reinterpret_cast<char const*>(data.data()), data.size())) {
+        auto const msg{
+            fmt::format("{}(): failed to write \'{}\'", __FUNCTION__, path.string())};
+        throw VocabularyError(msg);
+    }
+
+    spdlog::info("vocabulary successfully exported to the file \'{}\'", path.string());
+}
+
+void Vocabulary::exportToSnapshotFile(std::filesystem::path const& path) const
+{
+    Snapshot::write(path, store_, words_);
+}
+
+void Vocabulary::openSnapshot(std::filesystem::path const& path)
+{
+    snapshot_ = std::make_unique<Snapshot>(path);
+}
+
+std::optional<Word> Vocabulary::snapshotWord(std::string_view const word) const
+{
+    if (!snapshot_) {
+        return std::nullopt;
+    }
+    auto const index{snapshot_->find(word)};
+    if (!index) {
+        return std::nullopt;
+    }
+    return snapshot_->materialize(*index);
+}
+
+void Vocabulary::openJournal(std::filesystem::path const& journal_path,
+                             std::filesystem::path const& snapshot_path)
+{
+    closeJournal();
+
+    // journal_ stays empty while replaying, so replayed changes are not journaled again
+    auto journal{std::make_unique<Journal>(journal_path, journal_generation_ + 1)};
+    journal->replay(journalPosition(),
+                    [this](Journal::RecordType type, tools::binary::Reader& reader) {
+                        applyJournalRecord(type, reader);
+                    });
+
+    snapshot_path_ = snapshot_path;
+    journal_compaction_threshold_ = static_cast<size_t>(
+        common::Config::instance().getValue<int>(common::ConfigId::kJournalCompactionThreshold));
+    journal_ = std::move(journal);
+}
+
+void Vocabulary::closeJournal()
+{
+    journal_.reset();
+    snapshot_path_.clear();
+}
+
+void Vocabulary::compactJournal()
+{
+    if (!journal_) {
+        throw VocabularyError(fmt::format("{}(): journal is not opened", __FUNCTION__));
+    }
+    if (snapshots_in_progress_ > 0) {
+        throw VocabularyError(
+            fmt::format("{}(): snapshot is being saved in background", __FUNCTION__));
+    }
+
+    auto const previous_position{journalPosition()};
+    auto const position{journal_->position()};
+    journal_generation_ = position.generation;
+    journal_offset_ = position.offset;
+    try {
+        exportToJsonFile(snapshot_path_);
+    } catch (...) {
+        journal_generation_ = previous_position.generation;
+        journal_offset_ = previous_position.offset;
+        throw;
+    }
+    journal_->rotate(position.offset);
+
+    spdlog::info("journal compacted into \'{}\'", snapshot_path_.string());
+}
+
+std::unique_ptr<Vocabulary::Image> Vocabulary::beginSnapshot()
+{
+    auto result{std::make_unique<Image>()};
+    result->words_ = store_.copy(words_);
+    result->batch_cursor_ = learning_batch_.cursor();
+    for (auto const w : learning_batch_.words()) {
+        result->batch_.emplace_back(store_.word(w));
+    }
+    result->journal_position_ = journal_ ? journal_->position() : journalPosition();
+
+    ++snapshots_in_progress_;
+    return result;
+}
+
+void Vocabulary::finishSnapshot(std::filesystem::path const& path,
+                                Journal::Position const& position, bool saved)
+{
+    if (snapshots_in_progress_ > 0) {
+        --snapshots_in_progress_;
+    }
+
+    if (!saved || !journal_ || path != snapshot_path_ ||
+        journal_->generation() != position.generation) {
+        return;
+    }
+
+    journal_generation_ = position.generation;
+    journal_offset_ = position.offset;
+    try {
+        journal_->rotate(position.offset);
+    } catch (std::exception const& ex) {
+        // the journal is still valid, it'll be replayed from the saved offset
+        spdlog::error("{}(): {}", __FUNCTION__, ex.what());
     }
 }
 
 bool Vocabulary::addUnknownWordToBatch()
 {
-    if (batch_.size() >= kMaxWordsToLearn) {
+    if (learning_batch_.full()) {
         spdlog::warn("batch to learn is full");
         return false;
     }
 
-    auto w{nextUnknownWordToLearn()};
-    if (w.expired()) {
+    auto const w{learning_batch_.nextCandidate()};
+    if (!w) {
+        spdlog::warn("{}(): no words to learn, you know everything! ᕕ(⌐■_■)ᕗ ♪♬",
+                     __FUNCTION__);
         return false;
     }
+    spdlog::trace("word \'{}\' is added to the batch as unknown", store_.word(*w));
 
     // if the word is added to batch as "unknown",
     // let's mark it as "unknown" by pressing "don't know" button :)
-    w.lock()->dontKnow();
+    dontKnow(*w);
 
-    batch_.push_front(w);
+    learning_batch_.pushFront(*w);
+    journalBatch();
     return true;
 }
 
-Vocabulary::WordWeakPtr Vocabulary::nextWordToLearnFromBatch()
+std::optional<Vocabulary::WordHandle> Vocabulary::nextWordToLearnFromBatch()
 {
-    if (batch_.empty()) {
+    if (auto const due = nextDueWord(Scheduler::now())) {
+        spdlog::trace("word \'{}\' is due for review", store_.word(*due));
+        return due;
+    }
+
+    if (learning_batch_.empty()) {
         spdlog::warn("batch is empty");
-        return {};
-    }
-
-    while (!batch_.empty()) {
-        auto w = batch_.front();
-        batch_.pop_front();
-        if (auto word = w.lock()) {
-            if (word->retentionRate() < kRetentionRateForKnownWord) {
-                batch_.push_back(w);  // put it back to the deque
-                spdlog::trace("word \'{}\' returned from nextWordToLearnFromBatch()",
-                              word->word());
-                return w;
-            }
-        }
+        return std::nullopt;
     }
 
-    spdlog::warn("no words to learn in the batch");
-    return {};
+    auto const batch_size{learning_batch_.size()};
+    auto const result{learning_batch_.next()};
+
+    // only the words which left the batch are journaled, not the rotation
+    if (learning_batch_.size() != batch_size) {
+        journalBatch();
+    }
+    if (!result) {
+        spdlog::warn("no words to learn in the batch");
+        return std::nullopt;
+    }
+    spdlog::trace("word \'{}\' returned from nextWordToLearnFromBatch()",
+                  store_.word(*result));
+    return result;
 }
 
 // private ================================================
 
-Vocabulary::WordWeakPtr Vocabulary::findWord(std::string_view const word)
+void Vocabulary::addToIndex(WordHandle word)
 {
-    for (auto& w : words_) {
-        if (w->word() == word) {
-            return w;
+    due_index_.insert(word, store_.review(word));
+    if (reverse_index_built_) {
+        reverse_index_.insert(word, store_.variants(word));
+    }
+    if (search_index_built_) {
+        search_index_.add(word, store_.word(word), store_.variants(word));
+    }
+    known_words_count_ += isKnown(word) ? 1 : 0;
+}
+
+ReverseIndex const& Vocabulary::reverseIndex()
+{
+    if (!reverse_index_built_) {
+        for (auto const w : words_) {
+            reverse_index_.insert(w, store_.variants(w));
         }
+        reverse_index_built_ = true;
+        spdlog::debug("{}(): reverse index built, variants: {}", __FUNCTION__,
+                      reverse_index_.size());
+    }
+    return reverse_index_;
+}
+
+void Vocabulary::replaceWords(WordStore&& store, std::vector<WordHandle>&& words)
+{
+    // the batch refers the words of the replaced store
+    learning_batch_.discard();
+    store_ = std::move(store);
+    words_ = std::move(words);
+    rebuildIndex();
+    learning_batch_.reset(words_, 0);
+}
+
+void Vocabulary::rebuildIndex()
+{
+    due_index_.clear();
+    // built again by the next lookup
+    reverse_index_.clear();
+    reverse_index_built_ = false;
+    search_index_.clear();
+    search_index_built_ = false;
+    known_words_count_ = 0;
+    for (auto const w : words_) {
+        addToIndex(w);
     }
+}
 
-    spdlog::error("{}(): word {} is not found in the vocabulary", __FUNCTION__, word);
+void Vocabulary::review(WordHandle word, Grade grade, int64_t time)
+{
+    due_index_.erase(word, store_.review(word));
+    known_words_count_ -= isKnown(word) ? 1 : 0;
+    if (grade == Grade::kAgain) {
+        store_.dontKnow(word);
+    } else {
+        store_.know(word);
+    }
+    store_.setReview(word, scheduler_->review(store_.review(word), grade, time));
+    due_index_.insert(word, store_.review(word));
+    known_words_count_ += isKnown(word) ? 1 : 0;
+    learning_batch_.reviewed(word);
+}
 
-    return {};
+bool Vocabulary::isKnown(WordHandle word) const
+{
+    return store_.retentionRate(word) > kRetentionRateForKnownWord;
+}
+
+std::optional<Vocabulary::WordHandle> Vocabulary::nextDueWord(int64_t now) const
+{
+    // the batch words are learnt in the batch order, at most the batch size is skipped
+    std::optional<WordHandle> result;
+    due_index_.visit(now, [this, &result](WordHandle word) {
+        if (learning_batch_.contains(word)) {
+            return true;
+        }
+        result = word;
+        return false;
+    });
+    return result;
 }
 
 // Vocabulary::WordWeakPtr Vocabulary::nextRandomWordToLearn()
@@ -223,62 +837,243 @@ Vocabulary::WordWeakPtr Vocabulary::findWord(std::string_view const word)
 //     return {};
 // }
 
-Vocabulary::WordWeakPtr Vocabulary::nextUnknownWordToLearn()
+Vocabulary::MergeResult Vocabulary::mergeWord(Word&& word)
 {
-    if (words_.empty()) {
-        spdlog::warn("Nothing to learn. Vocabulary is empty.");
-        return {};
+    auto const present{store_.find(word.word())};
+    if (!present) {
+        addWord(std::move(word));
+        return MergeResult::kAdded;
     }
 
-    if (next_word_to_added_to_batch_ >= words_.size()) {
-        spdlog::warn("All words are known or were already in batches. Reset batch counter to 0");
-        next_word_to_added_to_batch_ = 0;  // reset index for next call
+    if (store_.addTranslation(*present, word.translation()) == 0) {
+        return MergeResult::kSkipped;
     }
-
-    try {
-        while (next_word_to_added_to_batch_ < words_.size()) {
-            auto w = words_.at(next_word_to_added_to_batch_++);
-            if (w->retentionRate() < kRetentionRateForKnownWord) {
-                spdlog::trace("word \'{}\' returned from nextUnknownWordToLearn()",
-                              w->word());
-                return w;
-            }
-        }
-    } catch (std::exception const& e) {
-        spdlog::error("{}(): can not get next unknown word: {}", __FUNCTION__, e.what());
-        return {};
+    if (reverse_index_built_) {
+        reverse_index_.insert(*present, store_.variants(*present));
+    }
+    if (search_index_built_) {
+        search_index_.update(*present, store_.word(*present), store_.variants(*present));
     }
 
-    spdlog::warn("{}(): no words to learn, you know everything! ᕕ(⌐■_■)ᕗ ♪♬",
-                 __FUNCTION__);
-
-    return {};
+    // the translation is journaled as a whole, only the missing parts are added on replay
+    if (journal_) {
+        tools::binary::Writer payload;
+        payload.writeString(word.word());
+        word.translation().toBin(payload);
+        journal(Journal::RecordType::kAddTranslation, payload);
+    }
+    return MergeResult::kMerged;
 }
 
 bool Vocabulary::addWordToBatch(std::string_view const word)
 {
-    if (batch_.size() >= kMaxWordsToLearn) {
-        spdlog::warn("batch to learn is full");
+    auto const word_to_add{find(word)};
+    if (!word_to_add) {
+        spdlog::warn("word \'{}\' is not found in the vocabulary", word);
         return false;
     }
 
-    auto word_to_add{findWord(word)};
-    if (word_to_add.expired()) {
-        spdlog::warn("word \'{}\' is not found in the vocabulary", word);
+    if (!learning_batch_.pushBack(*word_to_add)) {
+        spdlog::warn("word \'{}\' is not added, batch is full or contains it", word);
         return false;
     }
-
-    batch_.push_back(word_to_add);
     spdlog::trace("word \'{}\' added to the batch", word);
 
     return true;
 }
 
+void Vocabulary::setBatch(size_t cursor, std::vector<std::string> const& words)
+{
+    learning_batch_.clear();
+    learning_batch_.setCursor(cursor);
+    for (auto const& w : words) {
+        addWordToBatch(w);
+    }
+}
+
 uint8_t Vocabulary::targetRetentionRate() const
 {
     return kRetentionRateForKnownWord;
 }
 
+void Vocabulary::writeJson(std::ostream& output, int indent) const
+{
+    tools::json::StreamWriter writer{output, indent};
+    writer.beginObject();
+
+    std::vector<std::string_view> batch;
+    for (auto const word : learning_batch_.words()) {
+        batch.push_back(store_.word(word));
+    }
+    writeBatchJson(writer, learning_batch_.cursor(), batch, journalPosition());
+
+    writer.key("vocabulary").beginArray();
+    for (auto const word : words_) {
+        writeWordJson(writer, store_, word);
+    }
+    writer.endArray();
+
+    writer.endObject();
+}
+
+void Vocabulary::journal(Journal::RecordType type, tools::binary::Writer const& payload)
+{
+    if (!journal_) {
+        return;
+    }
+
+    if (journal_suspended_) {
+        if (suspended_records_) {
+            suspended_records_->writeU8(static_cast<uint8_t>(type));
+            suspended_records_->writeBytes(payload.data());
+            ++suspended_records_count_;
+        }
+        return;
+    }
+
+    // the change is already applied in memory, so a failed write must not break the
+    // caller; the change will be saved with the next snapshot
+    try {
+        journal_->append(type, payload);
+        if (journal_compaction_threshold_ > 0 && snapshots_in_progress_ == 0 &&
+            journal_->recordsCount() >= journal_compaction_threshold_) {
+            compactJournal();
+        }
+    } catch (std::exception const& ex) {
+        spdlog::error("{}(): {}", __FUNCTION__, ex.what());
+    }
+}
+
+void Vocabulary::journalWord(Journal::RecordType type, std::string_view const word)
+{
+    if (!journal_) {
+        return;
+    }
+    tools::binary::Writer payload;
+    payload.writeString(word);
+    journal(type, payload);
+}
+
+void Vocabulary::journalReview(Journal::RecordType type, std::string_view const word,
+                               int64_t time)
+{
+    if (!journal_) {
+        return;
+    }
+    tools::binary::Writer payload;
+    payload.writeString(word);
+    payload.writeI64(time);
+    journal(type, payload);
+}
+
+void Vocabulary::journalBatch()
+{
+    if (!journal_) {
+        return;
+    }
+    tools::binary::Writer payload;
+    payload.writeU64(learning_batch_.cursor());
+    auto const words{learning_batch_.words()};
+    payload.writeU32(static_cast<uint32_t>(words.size()));
+    for (auto const word : words) {
+        payload.writeString(store_.word(word));
+    }
+    journal(Journal::RecordType::kBatch, payload);
+}
+
+void Vocabulary::suspendJournal()
+{
+    journal_suspended_ = true;
+    suspended_records_count_ = 0;
+    if (journal_) {
+        suspended_records_ = std::make_unique<tools::binary::Writer>();
+    }
+}
+
+void Vocabulary::resumeJournal()
+{
+    journal_suspended_ = false;
+    auto const records{std::move(suspended_records_)};
+    if (!journal_ || !records || suspended_records_count_ == 0) {
+        return;
+    }
+
+    // it's cheaper to rewrite the snapshot once than to replay such a record on every start
+    if (journal_compaction_threshold_ > 0 && snapshots_in_progress_ == 0 &&
+        suspended_records_count_ >= journal_compaction_threshold_) {
+        try {
+            compactJournal();
+        } catch (std::exception const& ex) {
+            spdlog::error("{}(): {}", __FUNCTION__, ex.what());
+        }
+        return;
+    }
+
+    tools::binary::Writer payload{sizeof(uint32_t) + records->data().size()};
+    payload.writeU32(suspended_records_count_);
+    payload.writeBytes(records->data());
+    journal(Journal::RecordType::kImport, payload);
+}
+
+void Vocabulary::applyJournalRecord(Journal::RecordType type, tools::binary::Reader& reader)
+{
+    auto const findWord = [this](std::string_view const word) {
+        auto const w{find(word)};
+        if (!w) {
+            throw VocabularyError(fmt::format("word \'{}\' is not found", word));
+        }
+        return *w;
+    };
+
+    switch (type) {
+    case Journal::RecordType::kAddWord:
+        addWord(Word::fromBin(reader));
+        break;
+    case Journal::RecordType::kRemoveWord:
+        removeWord(reader.readString());
+        break;
+    case Journal::RecordType::kKnow:
+    case Journal::RecordType::kDontKnow: {
+        auto const word{findWord(reader.readString())};
+        // records written before scheduling was introduced have no review time
+        auto const time{reader.left() >= sizeof(int64_t) ? reader.readI64() : Scheduler::now()};
+        review(word, type == Journal::RecordType::kKnow ? Grade::kGood : Grade::kAgain, time);
+        break;
+    }
+    case Journal::RecordType::kAddTranslation: {
+        auto const word{findWord(reader.readString())};
+        if (store_.addTranslation(word, Translation::fromBin(reader)) > 0) {
+            if (reverse_index_built_) {
+                reverse_index_.insert(word, store_.variants(word));
+            }
+            if (search_index_built_) {
+                search_index_.update(word, store_.word(word), store_.variants(word));
+            }
+        }
+        break;
+    }
+    case Journal::RecordType::kImport: {
+        auto const count{reader.readU32()};
+        for (uint32_t i{0}; i < count; ++i) {
+            applyJournalRecord(static_cast<Journal::RecordType>(reader.readU8()), reader);
+        }
+        break;
+    }
+    case Journal::RecordType::kBatch: {
+        auto const cursor{reader.readU64()};
+        std::vector<std::string> words(reader.readU32());
+        for (auto& w : words) {
+            w = reader.readString();
+        }
+        setBatch(cursor, words);
+        break;
+    }
+    default:
+        throw ParsingError(fmt::format("unknown journal record type {}",
+                                       static_cast<int>(type)));
+    }
+}
+
 // ================================================================
 
 void to_json(nlohmann::json& j, std::vector<std::shared_ptr<Word>> const& words)
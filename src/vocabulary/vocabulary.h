@@ -1,17 +1,30 @@
 #ifndef VOCABULARY_VOCABULARY_H
 #define VOCABULARY_VOCABULARY_H
 
+#include <cstdint>
 #include <filesystem>
+#include <ostream>
 #include <string_view>
 #include <vector>
 #include <deque>
 #include <functional>
 #include <string>
 #include <memory>
+#include <optional>
+#include <unordered_map>
 
 #include "common/exceptions/vocabulary_error.h"
+#include "vocabulary/due_index.h"
+#include "vocabulary/journal.h"
+#include "vocabulary/learning_batch.h"
+#include "vocabulary/reverse_index.h"
+#include "vocabulary/scheduler.h"
+#include "vocabulary/search_index.h"
+#include "vocabulary/snapshot.h"
+#include "vocabulary/text_importer.h"
 #include "vocabulary/translation.h"
 #include "vocabulary/word.h"
+#include "vocabulary/word_store.h"
 
 #include "nlohmann/json.hpp"
 
@@ -21,7 +34,22 @@ constexpr const auto kDefaultVocabularyJsonPath{std::string_view{"../assets/voca
 
 class Vocabulary final {
 public:
-    using WordWeakPtr = std::weak_ptr<Word>;
+    // the word is valid until it's removed or the vocabulary is replaced by an import
+    using WordHandle = WordStore::Handle;
+
+    enum class ImportMode {
+        kAppend,  // every parsed line becomes a new word
+        kMerge,   // translations of the words which are already present are merged
+    };
+
+    struct ImportReport {
+        size_t added{};
+        size_t merged{};   // words which got new variants or examples
+        size_t skipped{};  // words which had nothing new
+        std::vector<TextImporter::LineError> errors;  // lines which can not be parsed
+        // words without translation which are not in the vocabulary, each one only once
+        std::vector<std::string> untranslated;
+    };
 
     struct Statistic {
         size_t words_count{};
@@ -30,55 +58,295 @@ public:
         size_t new_words_count{};
     };
 
+    /**
+     * Copy of the vocabulary state which is saved on another thread. The words are copied
+     * into a WordStore, i.e. a few arrays and one string arena instead of a Word and
+     * separately allocated strings per entry.
+     */
+    class Image final {
+    public:
+        /**
+         * The same json file as Vocabulary::exportToJsonFile() writes
+         * @throw VocabularyError if file can not be written
+         */
+        void exportToJsonFile(std::filesystem::path const& path, int indent = -1) const;
+        Journal::Position journalPosition() const { return journal_position_; }
+
+    private:
+        friend class Vocabulary;
+
+        WordStore words_;
+        size_t batch_cursor_{0};
+        std::vector<std::string> batch_;
+        Journal::Position journal_position_;
+
+        void writeJson(std::ostream& output, int indent) const;
+    };
+
 public:
     static char const kDefaultItemsDelimiter{';'};
     static char const kDefaultFieldsDelimiter{'|'};
-    static int const kMaxWordsToLearn{15};
+    static constexpr std::string_view kBinMagic{"VOCB"};
+    static constexpr uint16_t kBinVersion{2};
+
+    Vocabulary();
+    ~Vocabulary();
+
+    /**
+     * @return nullopt if word is not found
+     */
+    std::optional<WordHandle> find(std::string_view const word) const;
+
+    /**
+     * @throw VocabularyError if word is not found
+     */
+    Translation translate(std::string_view const word) const;
+
+    /**
+     * The words of the vocabulary, the handles returned by the vocabulary are read from it
+     */
+    WordStore const& store() const { return store_; }
+    bool contains(WordHandle word) const { return store_.valid(word); }
+    /**
+     * Standalone copy of the word
+     * @throw VocabularyError if the word has been removed
+     */
+    Word word(WordHandle word) const;
 
-    Vocabulary() = default;
+    /**
+     * Words and translation variants starting with the query, then the ones similar to it
+     * (see vocabulary::SearchIndex). The index is built by the first search and then kept
+     * up to date by every change.
+     */
+    std::vector<SearchIndex::Match> search(std::string_view const query, size_t limit);
 
     /**
+     * Reverse lookup for translation-first cards: words which have the variant among their
+     * translations (trimmed, ASCII case-insensitive), in O(1). As the search index, the
+     * reverse index is built by the first lookup and then kept up to date by every change.
+     */
+    std::vector<WordHandle> wordsByTranslation(std::string_view const variant);
+
+    /**
+     * Other words sharing at least one translation variant with the word, i.e. the words
+     * with the same meaning
      * @throw VocabularyError if word is not found
      */
-    Translation const& translate(std::string_view const word);
+    std::vector<WordHandle> synonyms(std::string_view const word);
     // void setStrategy(std::weak_ptr<LearningStrategies::Strategy> strategy);
 
+    /**
+     * The counters are kept up to date by every change, so it's O(1).
+     * Builds with check_vocabulary_counters option recount the known words to check them.
+     */
     Statistic getStatistic() const;
 
     void addWord(Word&& word);
     void addWord(std::string_view const word, Translation&& translation);
+    /**
+     * The words are journaled as one record, which is synced to the disk once. If there are
+     * kJournalCompactionThreshold words or more, the journal is compacted instead.
+     */
+    void addWords(std::vector<Word>&& words);
+
+    /**
+     * @return false if word is not found
+     */
+    bool removeWord(std::string_view const word);
+
+    // review results, they are journaled and scheduled; removed words are ignored
+    void know(WordHandle word);
+    void dontKnow(WordHandle word);
 
-    void importFromFile(std::filesystem::path const& path,
-                        char item_delim = kDefaultItemsDelimiter,
-                        char field_delim = kDefaultFieldsDelimiter);
+    /**
+     * Spaced repetition algorithm, which calculates when the reviewed words are due.
+     * By default it's chosen by kScheduler config value.
+     */
+    void setScheduler(std::unique_ptr<Scheduler> scheduler);
+    Scheduler const& scheduler() const { return *scheduler_; }
+
+    /**
+     * @param until unix time in seconds
+     * @return amount of the reviewed words which are due before or at `until`
+     */
+    size_t dueCount(int64_t until) const { return due_index_.count(until); }
+    // amount of the words which are due before the end of the current (local) day
+    size_t dueTodayCount() const;
+
+    /**
+     * Lines are parsed in parallel by kImportThreads workers (see vocabulary::TextImporter)
+     * and applied in the file order. Lines which can not be parsed are skipped.
+     * Lines which have only a word are reported as untranslated, so they can be translated
+     * and added later (see network::BulkTranslator).
+     * In kMerge mode a word which is already in the vocabulary (or earlier in the file)
+     * gets the variants and the examples it doesn't have yet, see Word::addTranslation().
+     * The imported words are not journaled one by one, see addWords().
+     * @throw VocabularyError if file can not be opened
+     */
+    ImportReport importFromFile(std::filesystem::path const& path,
+                                char item_delim = kDefaultItemsDelimiter,
+                                char field_delim = kDefaultFieldsDelimiter,
+                                ImportMode mode = ImportMode::kAppend);
     void exportToFile(std::filesystem::path const& path);
 
+    /**
+     * Replaces the state of the vocabulary, so the journal (if any) is closed
+     * @throw VocabularyError if file can not be opened or parsed
+     */
     void importFromJsonFile(std::filesystem::path const& path);
-    void exportToJsonFile(std::filesystem::path const& path) const;
+    /**
+     * Words are serialized straight into a temporary file, which replaces the target file
+     * once it's completely written and synced to the disk
+     * @param indent pretty-print with this amount of spaces, compact output if negative
+     * @throw VocabularyError if file can not be written
+     */
+    void exportToJsonFile(std::filesystem::path const& path, int indent = -1) const;
+
+    /**
+     * Binary format (all integers are little-endian, strings are u32 length + bytes):
+     * | magic "VOCB" | u16 version | u64 words count | words... |
+     * | u64 next word to be added to batch | u32 batch size | batch words... |
+     * word: | string word | i32 "don't know" | i32 "know" | translation | review (v2) |
+     * translation: | u32 count | variants... | u32 count | examples... |
+     * review: | i64 last review | i64 due | u32 interval | u32 repetitions | u32 lapses |
+     *         | f64 ease | f64 stability | f64 difficulty |
+     * Version 1 files (without review state) are still imported
+     * Import replaces the state of the vocabulary, so the journal (if any) is closed
+     * @throw VocabularyError if file can not be opened or parsed
+     */
+    void importFromBinFile(std::filesystem::path const& path);
+    void exportToBinFile(std::filesystem::path const& path) const;
+
+    /**
+     * Writes read-only snapshot, which can be memory-mapped by vocabulary::Snapshot
+     * @throw VocabularyError if file can not be written
+     */
+    void exportToSnapshotFile(std::filesystem::path const& path) const;
+
+    /**
+     * Maps read-only snapshot as a shared vocabulary, the words of which are added without
+     * translating them (see snapshotWord()). It doesn't depend on the snapshot size: the
+     * words and the counters are read from the mapping only when they are looked up.
+     * @throw VocabularyError if file can not be mapped or it's not a valid snapshot
+     */
+    void openSnapshot(std::filesystem::path const& path);
+    void closeSnapshot() { snapshot_.reset(); }
+    bool hasSnapshot() const { return snapshot_ != nullptr; }
+    /**
+     * Standalone copy of the word of the mapped snapshot with its counters,
+     * which can be added by addWord()
+     * @return nullopt if no snapshot is opened or the word is not in it
+     */
+    std::optional<Word> snapshotWord(std::string_view const word) const;
+
+    /**
+     * Replays the journal on top of the current state (which is expected to be loaded
+     * from `snapshot_path` json file) and records every further change into it.
+     * The journal is compacted into the snapshot automatically once it grows over
+     * kJournalCompactionThreshold records.
+     * @throw VocabularyError if journal can not be opened
+     */
+    void openJournal(std::filesystem::path const& journal_path,
+                     std::filesystem::path const& snapshot_path);
+    void closeJournal();
+    bool hasJournal() const { return journal_ != nullptr; }
 
+    /**
+     * Rewrites the json snapshot and rotates the journal
+     * @throw VocabularyError if journal is not opened or snapshot can not be written
+     */
+    void compactJournal();
+
+    /**
+     * Copy of the words and the batch which is going to be saved on another thread.
+     * The copy remembers the current journal position. Journal compaction is suspended
+     * until finishSnapshot() is called, so the snapshots are not written concurrently.
+     */
+    std::unique_ptr<Image> beginSnapshot();
+    /**
+     * Rotates the journal if the snapshot has been saved into the journal's snapshot file
+     * @param position journal position of the image returned by beginSnapshot()
+     */
+    void finishSnapshot(std::filesystem::path const& path, Journal::Position const& position,
+                        bool saved);
+    Journal::Position journalPosition() const { return {journal_generation_, journal_offset_}; }
+
+    /**
+     * Adds the next word below the target retention rate to the front of the batch
+     * @return false if the batch is full or there are no words to learn
+     */
     bool addUnknownWordToBatch();
-    WordWeakPtr nextWordToLearnFromBatch();
-    size_t batchSize() const { return batch_.size(); }
+    /**
+     * Reviewed words which are due now and are not in the batch go first, the most
+     * overdue one is returned; otherwise the next word of the batch
+     */
+    std::optional<WordHandle> nextWordToLearnFromBatch();
+    size_t batchSize() const { return learning_batch_.size(); }
+    size_t batchCapacity() const { return learning_batch_.capacity(); }
+    void setBatchCapacity(size_t capacity) { learning_batch_.setCapacity(capacity); }
     uint8_t targetRetentionRate() const;
 
 private:
-    using Batch = std::deque<WordWeakPtr>;
+    // the store is searched by its own index, the first added word wins for duplicates
+    WordStore store_;
+    // words in the vocabulary order
+    std::vector<WordHandle> words_;
 
-    std::vector<std::shared_ptr<Word>> words_;
+    LearningBatch learning_batch_;
+    std::unique_ptr<Scheduler> scheduler_;
+    DueIndex due_index_;
+    SearchIndex search_index_;
+    ReverseIndex reverse_index_;
+    bool reverse_index_built_{false};
+    bool search_index_built_{false};
+    size_t known_words_count_{0};
 
-    Batch batch_;
+    // shared read-only vocabulary, not a part of the state
+    std::unique_ptr<Snapshot> snapshot_;
 
-    size_t next_word_index_{0};
-    size_t next_word_to_added_to_batch_{0};
+    std::unique_ptr<Journal> journal_;
+    std::filesystem::path snapshot_path_;
+    // journal position included into the snapshot this state has been loaded from
+    uint64_t journal_generation_{0};
+    size_t journal_offset_{0};
+    size_t snapshots_in_progress_{0};
+    size_t journal_compaction_threshold_{0};
+    // changes are not journaled while an import is applied, see suspendJournal()
+    bool journal_suspended_{false};
+    std::unique_ptr<tools::binary::Writer> suspended_records_;
+    uint32_t suspended_records_count_{0};
 
-    /**
-     * @throw VocabularyError if word is not found
-     */
-    WordWeakPtr findWord(std::string_view const word);
+    void addToIndex(WordHandle word);
+    ReverseIndex const& reverseIndex();
+    // replaces the words of the vocabulary, the handles are in the vocabulary order
+    void replaceWords(WordStore&& store, std::vector<WordHandle>&& words);
+    void rebuildIndex();
 
-    WordWeakPtr nextUnknownWordToLearn();
+    bool isKnown(WordHandle word) const;
+
+    void review(WordHandle word, Grade grade, int64_t time);
+    std::optional<WordHandle> nextDueWord(int64_t now) const;
+
+    enum class MergeResult {
+        kAdded,
+        kMerged,
+        kSkipped,
+    };
+    MergeResult mergeWord(Word&& word);
 
     bool addWordToBatch(std::string_view const word);
+    void setBatch(size_t cursor, std::vector<std::string> const& words);
+
+    void writeJson(std::ostream& output, int indent) const;
+
+    void journal(Journal::RecordType type, tools::binary::Writer const& payload);
+    void journalWord(Journal::RecordType type, std::string_view const word);
+    void journalReview(Journal::RecordType type, std::string_view const word, int64_t time);
+    void journalBatch();
+    // records of the changes are collected until resumeJournal() journals them at once
+    void suspendJournal();
+    void resumeJournal();
+    void applyJournalRecord(Journal::RecordType type, tools::binary::Reader& reader);
 };
 
 void to_json(nlohmann::json& j, std::vector<std::shared_ptr<Word>> const& words);
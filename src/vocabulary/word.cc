@@ -2,28 +2,27 @@
 
 #include "common/exceptions/parsing_error.h"
 #include "spdlog/spdlog.h"
+#include "tools/binary_stream.h"
 #include "tools/string_utils.h"
 
-// #include <algorithm>
+#include <algorithm>
 #include <stdexcept>
 
 namespace vocabulary {
 
 Word Word::parse(std::string_view str, char item_delim, char field_delim)
 {
-    auto string{std::string{str}};
+    using namespace tools::string_utils;
 
-    spdlog::trace("string to parse: {}", string);
+    spdlog::trace("string to parse: {}", str);
 
-    tools::string_utils::removePrefixSpacesAndTabs(string);
-    tools::string_utils::removePrefix(string, field_delim);
+    // the word and the translation are slices of `str`, only the stored strings are allocated
+    auto string{withoutPrefix(withoutPrefixSpacesAndTabs(str), field_delim)};
 
     const auto end{string.find(field_delim)};
-    auto word{string.substr(0, end)};
+    auto const word{trimmed(string.substr(0, end))};
 
-    tools::string_utils::trim(word);
-
-    if (word.find(item_delim) != std::string::npos) {
+    if (word.find(item_delim) != std::string_view::npos) {
         throw ParsingError{"\'word\' can contain only one variant"};
     }
 
@@ -31,7 +30,7 @@ Word Word::parse(std::string_view str, char item_delim, char field_delim)
         throw ParsingError{"word can not be empty string"};
     }
 
-    string.erase(0, (end == std::string::npos ? string.size() : end));
+    string.remove_prefix(end == std::string_view::npos ? string.size() : end);
     return {word, Translation::parse(string, item_delim, field_delim)};
 }
 
@@ -48,22 +47,27 @@ Word::Word(std::string_view word, Translation&& translation, int impressions_num
     setDelimiters(translation_.delimiters().first, translation_.delimiters().second);
 }
 
-std::string Word::word() const { return word_; }
+std::string const& Word::word() const { return word_; }
 
-void Word::addTranslation(Translation&& translation)
+size_t Word::addTranslation(Translation const& translation)
 {
-    for (auto const& v : translation.variants()) {
-        translation_.addVariant(v);
-    }
-    for (auto const& e : translation.examples()) {
-        translation_.addExample(e);
-    }
-    // std::for_each(translation.variants().begin(), translation.variants().end(),
-    //               [&translation_=translation_](const auto& element) {
-    //               translation_.addVariant(element); });
-    // std::for_each(translation.examples().begin(), translation.examples().end(),
-    //               [&translation_=translation_](const auto& element) {
-    //               translation_.addExample(element); });
+    // a word has a handful of variants, so the linear search is cheaper than a set
+    auto const addMissing = [](std::vector<std::string> const& present,
+                               std::vector<std::string> const& incoming, auto&& add) {
+        size_t added{0};
+        for (auto const& item : incoming) {
+            if (std::ranges::find(present, item) == present.end()) {
+                add(item);
+                ++added;
+            }
+        }
+        return added;
+    };
+
+    return addMissing(translation_.variants(), translation.variants(),
+                      [this](auto const& v) { translation_.addVariant(v); }) +
+           addMissing(translation_.examples(), translation.examples(),
+                      [this](auto const& e) { translation_.addExample(e); });
 }
 
 Translation const& Word::translation() const { return translation_; }
@@ -74,6 +78,25 @@ std::string Word::toString() const
            field_delimiter_;
 }
 
+void Word::toBin(tools::binary::Writer& writer) const
+{
+    writer.writeString(word_);
+    writer.writeI32(dont_know_pressed_number_);
+    writer.writeI32(know_pressed_number_);
+    translation_.toBin(writer);
+}
+
+Word Word::fromBin(tools::binary::Reader& reader)
+{
+    auto const word{reader.readString()};
+    if (word.empty()) {
+        throw ParsingError{"binary word can not be empty string"};
+    }
+    auto const dont_know_number{reader.readI32()};
+    auto const know_number{reader.readI32()};
+    return {word, Translation::fromBin(reader), dont_know_number, know_number};
+}
+
 uint8_t Word::retentionRate() const {
     // retention rate as simple percentage rate
     // if (know_pressed_number_ + dont_know_pressed_number_ == 0) {
@@ -114,6 +137,10 @@ void to_json(nlohmann::json& j, Word const& w)
 {
     j = nlohmann::json{{"word", w.word()}, {"translation", w.translation()},
                        {"dont_know", w.dontKnowNumber()}, {"know", w.knowNumber()}};
+    // never reviewed words are stored as before scheduling was introduced
+    if (w.review().reviewed()) {
+        j["review"] = w.review();
+    }
 }
 
 void from_json(nlohmann::json const& j, Word& w)
@@ -123,6 +150,29 @@ void from_json(nlohmann::json const& j, Word& w)
     int dont_know_number = j.at("dont_know");
     int know_number = j.at("know");
     w = Word(word, std::move(translation), dont_know_number, know_number);
+    if (j.contains("review")) {
+        w.setReview(j.at("review").get<ReviewState>());
+    }
+}
+
+void to_json(nlohmann::json& j, ReviewState const& r)
+{
+    j = nlohmann::json{{"last_review", r.last_review}, {"due", r.due},
+                       {"interval", r.interval},       {"repetitions", r.repetitions},
+                       {"lapses", r.lapses},           {"ease", r.ease},
+                       {"stability", r.stability},     {"difficulty", r.difficulty}};
+}
+
+void from_json(nlohmann::json const& j, ReviewState& r)
+{
+    r.last_review = j.at("last_review");
+    r.due = j.at("due");
+    r.interval = j.value("interval", uint32_t{});
+    r.repetitions = j.value("repetitions", uint32_t{});
+    r.lapses = j.value("lapses", uint32_t{});
+    r.ease = j.value("ease", ReviewState{}.ease);
+    r.stability = j.value("stability", 0.0);
+    r.difficulty = j.value("difficulty", 0.0);
 }
 
 bool operator<(std::reference_wrapper<Word> lhs, std::reference_wrapper<Word> rhs)
@@ -5,6 +5,7 @@
 #include <string>
 #include <string_view>
 
+#include "vocabulary/review_state.h"
 #include "vocabulary/translation.h"
 
 #include "nlohmann/json.hpp"
@@ -36,17 +37,32 @@ public:
     // Word(Word const& other) = default;
     // Word& operator=(Word const& other) = default;
 
-    std::string word() const;
-    void addTranslation(Translation&& translation);
+    std::string const& word() const;
+    /**
+     * Appends the variants and the examples which the word doesn't have yet
+     * @return amount of the appended variants and examples
+     */
+    size_t addTranslation(Translation const& translation);
     Translation const& translation() const;
     std::string toString() const;
 
+    void toBin(tools::binary::Writer& writer) const;
+
+    /**
+     * @throw ParsingError if data is truncated or fields are empty
+     */
+    static Word fromBin(tools::binary::Reader& reader);
+
     uint8_t retentionRate() const;
     int dontKnowNumber() const { return dont_know_pressed_number_; }
     int knowNumber() const { return know_pressed_number_; }
     void know() { ++know_pressed_number_; }
     void dontKnow() { ++dont_know_pressed_number_; }
 
+    // spaced repetition state, it's changed by the Vocabulary scheduler
+    ReviewState const& review() const { return review_; }
+    void setReview(ReviewState const& review) { review_ = review; }
+
     void setDelimiters(char item_delim, char field_delim);
 
     bool operator<(Word const& other) const;
@@ -57,6 +73,7 @@ private:
     int know_pressed_number_{};
     std::string word_;
     Translation translation_;
+    ReviewState review_;
 
     inline static char item_delimiter_{kDefaultItemsDelimiter};
     inline static char field_delimiter_{kDefaultFieldsDelimiter};
@@ -65,6 +82,9 @@ private:
 void to_json(nlohmann::json& j, Word const& w);
 void from_json(nlohmann::json const& j, Word& w);
 
+void to_json(nlohmann::json& j, ReviewState const& r);
+void from_json(nlohmann::json const& j, ReviewState& r);
+
 bool operator<(std::reference_wrapper<Word> lhs, std::reference_wrapper<Word> rhs);
 bool operator==(std::reference_wrapper<Word> lhs, std::reference_wrapper<Word> rhs);
 
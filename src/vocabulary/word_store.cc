@@ -0,0 +1,293 @@
+#include "vocabulary/word_store.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "spdlog/spdlog.h"
+
+namespace vocabulary {
+
+WordStore WordStore::copy(std::span<Handle const> handles) const
+{
+    WordStore result;
+    result.dont_know_.reserve(handles.size());
+    result.know_.reserve(handles.size());
+    result.alive_.reserve(handles.size());
+    result.generations_.reserve(handles.size());
+    result.words_.reserve(handles.size());
+    result.first_ref_.reserve(handles.size());
+    result.variants_count_.reserve(handles.size());
+    result.examples_count_.reserve(handles.size());
+    result.reviews_.reserve(handles.size());
+    result.index_.reserve(handles.size());
+
+    for (auto const handle : handles) {
+        auto const index{slot(handle)};
+        auto const copy_index{static_cast<uint32_t>(result.generations_.size())};
+        result.dont_know_.push_back(dont_know_[index]);
+        result.know_.push_back(know_[index]);
+        result.alive_.push_back(true);
+        result.generations_.push_back(0);
+        result.words_.push_back(result.arena_.store(words_[index]));
+        result.first_ref_.push_back(static_cast<uint32_t>(result.refs_.size()));
+        result.variants_count_.push_back(variants_count_[index]);
+        result.examples_count_.push_back(examples_count_[index]);
+        result.reviews_.push_back(reviews_[index]);
+        for (uint32_t r{0}; r < variants_count_[index] + examples_count_[index]; ++r) {
+            result.refs_.push_back(result.arena_.store(refs_[first_ref_[index] + r]));
+        }
+        result.index_.try_emplace(result.words_.back(), copy_index);
+    }
+    return result;
+}
+
+WordStore::Handle WordStore::add(std::string_view word, std::span<std::string const> variants,
+                                 std::span<std::string const> examples,
+                                 int dont_know_number, int know_number)
+{
+    if (word.empty()) {
+        throw std::invalid_argument{"word can not be empty string"};
+    }
+    if (variants.size() > std::numeric_limits<uint16_t>::max() ||
+        examples.size() > std::numeric_limits<uint16_t>::max()) {
+        throw std::invalid_argument{"too many variants or examples"};
+    }
+
+    uint32_t index{};
+    if (free_slots_.empty()) {
+        index = static_cast<uint32_t>(generations_.size());
+        dont_know_.push_back(dont_know_number);
+        know_.push_back(know_number);
+        alive_.push_back(true);
+        generations_.push_back(0);
+        words_.emplace_back();
+        first_ref_.push_back(0);
+        variants_count_.push_back(0);
+        examples_count_.push_back(0);
+        reviews_.emplace_back();
+    } else {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+        dont_know_[index] = dont_know_number;
+        know_[index] = know_number;
+        alive_[index] = true;
+        reviews_[index] = {};
+    }
+
+    words_[index] = arena_.store(word);
+    first_ref_[index] = storeRefs(variants, examples);
+    variants_count_[index] = static_cast<uint16_t>(variants.size());
+    examples_count_[index] = static_cast<uint16_t>(examples.size());
+    index_.try_emplace(words_[index], index);
+
+    return {index, generations_[index]};
+}
+
+WordStore::Handle WordStore::add(Word const& word)
+{
+    auto const& translation{word.translation()};
+    auto const handle{add(word.word(), translation.variants(), translation.examples(),
+                          word.dontKnowNumber(), word.knowNumber())};
+    reviews_[handle.index] = word.review();
+    return handle;
+}
+
+bool WordStore::remove(Handle handle)
+{
+    if (!valid(handle)) {
+        return false;
+    }
+
+    auto const index{handle.index};
+    if (auto const it = index_.find(words_[index]); it != index_.end() && it->second == index) {
+        index_.erase(it);
+    }
+    garbage_bytes_ += words_[index].size();
+    for (uint32_t r{0}; r < variants_count_[index] + examples_count_[index]; ++r) {
+        garbage_bytes_ += sizeof(std::string_view) + refs_[first_ref_[index] + r].size();
+    }
+    alive_[index] = false;
+    ++generations_[index];
+    variants_count_[index] = 0;
+    examples_count_[index] = 0;
+    words_[index] = {};
+    free_slots_.push_back(index);
+    return true;
+}
+
+size_t WordStore::addTranslation(Handle handle, Translation const& translation)
+{
+    auto const index{slot(handle)};
+
+    // a word has a handful of variants, so the linear search is cheaper than a set
+    auto const missing = [](std::span<std::string_view const> present,
+                            std::vector<std::string> const& incoming) {
+        std::vector<std::string_view> result;
+        for (auto const& item : incoming) {
+            if (std::ranges::find(present, item) == present.end() &&
+                std::ranges::find(result, item) == result.end()) {
+                result.push_back(item);
+            }
+        }
+        return result;
+    };
+    auto const new_variants{missing(variants(handle), translation.variants())};
+    auto const new_examples{missing(examples(handle), translation.examples())};
+    if (new_variants.empty() && new_examples.empty()) {
+        return 0;
+    }
+    if (variants_count_[index] + new_variants.size() > std::numeric_limits<uint16_t>::max() ||
+        examples_count_[index] + new_examples.size() > std::numeric_limits<uint16_t>::max()) {
+        throw std::invalid_argument{"too many variants or examples"};
+    }
+
+    // the references of the word are contiguous, so they are moved to the end; the text
+    // of the present ones is shared, only the old references become garbage
+    std::vector<std::string_view> refs;
+    refs.reserve(variants_count_[index] + examples_count_[index] + new_variants.size() +
+                 new_examples.size());
+    auto const present_variants{variants(handle)};
+    auto const present_examples{examples(handle)};
+    refs.insert(refs.end(), present_variants.begin(), present_variants.end());
+    for (auto const v : new_variants) {
+        refs.push_back(arena_.store(v));
+    }
+    refs.insert(refs.end(), present_examples.begin(), present_examples.end());
+    for (auto const e : new_examples) {
+        refs.push_back(arena_.store(e));
+    }
+
+    garbage_bytes_ += (variants_count_[index] + examples_count_[index]) * sizeof(std::string_view);
+    first_ref_[index] = static_cast<uint32_t>(refs_.size());
+    refs_.insert(refs_.end(), refs.begin(), refs.end());
+    variants_count_[index] = static_cast<uint16_t>(variants_count_[index] + new_variants.size());
+    examples_count_[index] = static_cast<uint16_t>(examples_count_[index] + new_examples.size());
+    return new_variants.size() + new_examples.size();
+}
+
+bool WordStore::valid(Handle handle) const
+{
+    return handle.index < generations_.size() && alive_[handle.index] &&
+           generations_[handle.index] == handle.generation;
+}
+
+std::optional<WordStore::Handle> WordStore::find(std::string_view word) const
+{
+    if (auto const it = index_.find(word); it != index_.end()) {
+        return Handle{it->second, generations_[it->second]};
+    }
+    return std::nullopt;
+}
+
+std::string_view WordStore::word(Handle handle) const { return words_[slot(handle)]; }
+
+std::span<std::string_view const> WordStore::variants(Handle handle) const
+{
+    auto const index{slot(handle)};
+    return std::span{refs_}.subspan(first_ref_[index], variants_count_[index]);
+}
+
+std::span<std::string_view const> WordStore::examples(Handle handle) const
+{
+    auto const index{slot(handle)};
+    return std::span{refs_}.subspan(first_ref_[index] + variants_count_[index],
+                                    examples_count_[index]);
+}
+
+uint8_t WordStore::retentionRate(Handle handle) const
+{
+    // the same as Word::retentionRate()
+    auto const index{slot(handle)};
+    return static_cast<uint8_t>(std::max(0, know_[index] - dont_know_[index]));
+}
+
+size_t WordStore::countKnown(int target_retention_rate) const
+{
+    size_t result{0};
+    for (size_t i{0}; i < know_.size(); ++i) {
+        auto const rate{static_cast<uint8_t>(std::max(0, know_[i] - dont_know_[i]))};
+        result += alive_[i] && rate > target_retention_rate ? 1 : 0;
+    }
+    return result;
+}
+
+Word WordStore::materialize(Handle handle) const
+{
+    auto const toVector = [](std::span<std::string_view const> strs) {
+        return std::vector<std::string>{strs.begin(), strs.end()};
+    };
+
+    auto const index{slot(handle)};
+    Word result{words_[index], Translation{toVector(variants(handle)), toVector(examples(handle))},
+                dont_know_[index], know_[index]};
+    result.setReview(reviews_[index]);
+    return result;
+}
+
+void WordStore::compact()
+{
+    auto const old_refs{std::move(refs_)};
+    auto old_arena{std::move(arena_)};
+    auto const old_index{std::move(index_)};
+    arena_ = {};
+    refs_ = {};
+    index_ = {};
+    index_.reserve(old_index.size());
+
+    for (uint32_t i{0}; i < generations_.size(); ++i) {
+        if (!alive_[i]) {
+            continue;
+        }
+        words_[i] = arena_.store(words_[i]);
+        auto const first{static_cast<uint32_t>(refs_.size())};
+        for (uint32_t r{0}; r < variants_count_[i] + examples_count_[i]; ++r) {
+            refs_.push_back(arena_.store(old_refs[first_ref_[i] + r]));
+        }
+        first_ref_[i] = first;
+    }
+    // the same words win for the duplicates
+    for (auto const& [word, index] : old_index) {
+        index_.try_emplace(words_[index], index);
+    }
+    garbage_bytes_ = 0;
+
+    spdlog::trace("{}(): {} bytes of text kept", __FUNCTION__, arena_.size());
+}
+
+size_t WordStore::memoryUsage() const
+{
+    auto const bytes = [](auto const& v) { return v.capacity() * sizeof(v[0]); };
+    // node: key, value, next pointer and cached hash; plus the bucket pointer
+    auto const index_bytes{index_.size() * (sizeof(std::string_view) + 2 * sizeof(void*) +
+                                            sizeof(uint32_t) + sizeof(size_t)) +
+                           index_.bucket_count() * sizeof(void*)};
+    return bytes(dont_know_) + bytes(know_) + bytes(alive_) + bytes(generations_) +
+           bytes(words_) + bytes(first_ref_) + bytes(variants_count_) +
+           bytes(examples_count_) + bytes(reviews_) + bytes(refs_) + bytes(free_slots_) +
+           arena_.capacity() + index_bytes;
+}
+
+// private ================================================
+
+uint32_t WordStore::slot(Handle handle) const
+{
+    if (!valid(handle)) {
+        throw std::out_of_range{"stale word handle"};
+    }
+    return handle.index;
+}
+
+uint32_t WordStore::storeRefs(std::span<std::string const> variants,
+                              std::span<std::string const> examples)
+{
+    auto const first{static_cast<uint32_t>(refs_.size())};
+    for (auto const& v : variants) {
+        refs_.push_back(arena_.store(v));
+    }
+    for (auto const& e : examples) {
+        refs_.push_back(arena_.store(e));
+    }
+    return first;
+}
+
+}  // namespace vocabulary
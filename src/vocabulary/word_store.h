@@ -0,0 +1,157 @@
+#ifndef VOCABULARY_WORD_STORE_H
+#define VOCABULARY_WORD_STORE_H
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "tools/string_arena.h"
+#include "vocabulary/review_state.h"
+#include "vocabulary/word.h"
+
+namespace vocabulary {
+
+/**
+ * Mutable struct-of-arrays word storage, the words of the Vocabulary live in it.
+ * The counters which are read by the scans ("know", "don't know") live in contiguous
+ * arrays, the text of the words, variants and examples is stored in one string arena,
+ * so a word costs a few fixed-size slots instead of a shared_ptr, a Word and a separate
+ * heap allocation per string.
+ *
+ * Words are addressed by handles, which stay valid until the word is removed. The slot
+ * of the removed word is reused with the next generation, so a stale handle is detected
+ * instead of pointing to another word.
+ * The string_views returned by the store are valid until it's compacted.
+ */
+class WordStore final {
+public:
+    struct Handle {
+        static uint32_t const kInvalidIndex{std::numeric_limits<uint32_t>::max()};
+
+        uint32_t index{kInvalidIndex};
+        uint32_t generation{};
+
+        bool operator==(Handle const& other) const = default;
+    };
+
+    struct HandleHash {
+        size_t operator()(Handle const handle) const
+        {
+            return std::hash<uint64_t>{}(uint64_t{handle.index} << 32 | handle.generation);
+        }
+    };
+
+    WordStore() = default;
+    WordStore(WordStore&& other) = default;
+    WordStore& operator=(WordStore&& other) = default;
+    WordStore(WordStore const& other) = delete;
+    WordStore& operator=(WordStore const& other) = delete;
+
+    /**
+     * Compact copy of the words in the order of the handles, the slots of the copy follow
+     * this order
+     */
+    WordStore copy(std::span<Handle const> handles) const;
+
+    /**
+     * @throw std::invalid_argument if word is empty string or there are more than
+     * 65535 variants or examples
+     */
+    Handle add(std::string_view word, std::span<std::string const> variants,
+               std::span<std::string const> examples, int dont_know_number = 0,
+               int know_number = 0);
+    Handle add(Word const& word);
+    // @return false if the handle is stale
+    bool remove(Handle handle);
+    /**
+     * Appends the variants and the examples which the word doesn't have yet, as
+     * Word::addTranslation() does
+     * @return amount of the appended variants and examples
+     */
+    size_t addTranslation(Handle handle, Translation const& translation);
+    bool valid(Handle handle) const;
+
+    // the first added word wins, as Vocabulary::translate() does
+    std::optional<Handle> find(std::string_view word) const;
+
+    // amount of stored words
+    size_t size() const { return index_.size(); }
+
+    /**
+     * Accessors expect a valid handle
+     * @throw std::out_of_range if the handle is stale
+     */
+    std::string_view word(Handle handle) const;
+    std::span<std::string_view const> variants(Handle handle) const;
+    std::span<std::string_view const> examples(Handle handle) const;
+    int dontKnowNumber(Handle handle) const { return dont_know_[slot(handle)]; }
+    int knowNumber(Handle handle) const { return know_[slot(handle)]; }
+    uint8_t retentionRate(Handle handle) const;
+    void know(Handle handle) { ++know_[slot(handle)]; }
+    void dontKnow(Handle handle) { ++dont_know_[slot(handle)]; }
+    ReviewState const& review(Handle handle) const { return reviews_[slot(handle)]; }
+    void setReview(Handle handle, ReviewState const& review) { reviews_[slot(handle)] = review; }
+
+    // scans only the counters arrays
+    size_t countKnown(int target_retention_rate) const;
+
+    // calls `visitor(Handle)` for every stored word in slot order
+    template <typename Visitor>
+    void forEach(Visitor&& visitor) const
+    {
+        for (uint32_t i{0}; i < generations_.size(); ++i) {
+            if (alive_[i]) {
+                visitor(Handle{i, generations_[i]});
+            }
+        }
+    }
+
+    // creates a standalone (owning) copy of the word
+    Word materialize(Handle handle) const;
+
+    /**
+     * Text of the removed words (and the references to the replaced variants) stays in the
+     * store until it's compacted. Handles are kept valid, string_views are not.
+     */
+    void compact();
+    // bytes which compact() would release
+    size_t garbageBytes() const { return garbage_bytes_; }
+
+    // bytes held by the store: arrays capacity, arena blocks and the hash index
+    size_t memoryUsage() const;
+
+private:
+    // hot data
+    std::vector<int32_t> dont_know_;
+    std::vector<int32_t> know_;
+    std::vector<uint8_t> alive_;
+    std::vector<uint32_t> generations_;
+
+    // cold data
+    std::vector<std::string_view> words_;
+    std::vector<uint32_t> first_ref_;
+    std::vector<uint16_t> variants_count_;
+    std::vector<uint16_t> examples_count_;
+    std::vector<ReviewState> reviews_;
+    // variants and examples of all the words: variants of the word go first
+    std::vector<std::string_view> refs_;
+    tools::StringArena arena_;
+
+    std::vector<uint32_t> free_slots_;
+    std::unordered_map<std::string_view, uint32_t> index_;
+    size_t garbage_bytes_{0};
+
+    uint32_t slot(Handle handle) const;
+    uint32_t storeRefs(std::span<std::string const> variants,
+                       std::span<std::string const> examples);
+};
+
+}  // namespace vocabulary
+
+#endif  // VOCABULARY_WORD_STORE_H
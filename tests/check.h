@@ -0,0 +1,57 @@
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#include <cstddef>
+#include <iostream>
+#include <source_location>
+
+// checks shared by the test executables: a failed check is reported and counted, the test
+// goes on, so one run shows all the failures
+namespace tests {
+
+// the first failures are enough to find the cause
+constexpr size_t kReportedFailures{20};
+
+inline size_t& failuresCounter()
+{
+    static size_t failures{0};
+    return failures;
+}
+
+inline size_t failures() { return failuresCounter(); }
+
+inline bool check(bool passed, char const* expression,
+                  std::source_location const location = std::source_location::current())
+{
+    if (!passed) {
+        if (++failuresCounter() <= kReportedFailures) {
+            std::cerr << location.file_name() << ':' << location.line()
+                      << ": check failed: " << expression << '\n';
+        }
+    }
+    return passed;
+}
+
+template <typename Lhs, typename Rhs>
+bool checkEqual(Lhs const& lhs, Rhs const& rhs, char const* expression,
+                std::source_location const location = std::source_location::current())
+{
+    if (lhs == rhs) {
+        return true;
+    }
+    check(false, expression, location);
+    if (failures() <= kReportedFailures) {
+        std::cerr << "  values: " << lhs << " != " << rhs << '\n';
+    }
+    return false;
+}
+
+// exit code of the test executable
+inline int result() { return failures() == 0 ? 0 : 1; }
+
+}  // namespace tests
+
+#define CHECK(expression) tests::check((expression), #expression)
+#define CHECK_EQ(lhs, rhs) tests::checkEqual((lhs), (rhs), #lhs " == " #rhs)
+
+#endif  // TESTS_CHECK_H
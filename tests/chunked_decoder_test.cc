@@ -0,0 +1,171 @@
+/**
+ * Test of the chunked body decoding: ChunkedDecoder fed in parts of every size, and
+ * HttpClient reading chunked responses of the local stand-in server, which writes them in
+ * single bytes, splits the chunk size lines, adds chunk extensions and trailers or closes
+ * the connection in the middle of the body.
+ */
+
+#include <future>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common/config/config.h"
+#include "network/http/chunked_decoder.h"
+#include "network/http/client/nttp_client.h"
+#include "tests/check.h"
+#include "tests/http_server.h"
+
+namespace {
+
+// chunk extensions, hex digits and trailer fields, as servers send them
+constexpr std::string_view kChunked{
+    "5;name=value\r\nHello\r\n"
+    "19; quoted=\"a;b\"\r\n, the chunked body which \r\n"
+    "3\r\nis \r\n"
+    "8\r\ncomplete\r\n"
+    "0\r\nExpires: never\r\nX-Checksum: 1\r\n\r\n"};
+constexpr std::string_view kBody{"Hello, the chunked body which is complete"};
+
+struct Decoded {
+    bool done{};
+    bool failed{};
+    size_t consumed{};
+    std::string body;
+};
+
+// feeds the data in parts of `size` bytes, the rest of a part which has not been consumed
+// is fed again with the next one, as readBody() does
+Decoded decode(std::string_view data, size_t size)
+{
+    network::ChunkedDecoder decoder;
+    Decoded result;
+    std::string buffer;
+    for (size_t pos{0}; pos < data.size() && !decoder.done() && !decoder.failed();
+         pos += size) {
+        buffer += data.substr(pos, size);
+        auto const consumed{decoder.feed(buffer)};
+        buffer.erase(0, consumed);
+        result.consumed += consumed;
+    }
+    result.done = decoder.done();
+    result.failed = decoder.failed();
+    result.body = decoder.release();
+    return result;
+}
+
+void checkDecoder()
+{
+    for (size_t size{1}; size <= kChunked.size(); ++size) {
+        auto const decoded{decode(kChunked, size)};
+        CHECK(decoded.done);
+        CHECK_EQ(decoded.body, kBody);
+        CHECK_EQ(decoded.consumed, kChunked.size());
+    }
+
+    // whatever follows the body is left to the next response
+    auto const next{std::string{kChunked} + "HTTP/1.1 200 OK\r\n"};
+    CHECK_EQ(decode(next, next.size()).consumed, kChunked.size());
+
+    // the body is not over yet
+    for (size_t length{0}; length < kChunked.size(); ++length) {
+        auto const decoded{decode(kChunked.substr(0, length), 1)};
+        CHECK(!decoded.done);
+        CHECK(!decoded.failed);
+    }
+
+    for (std::string_view const malformed : {
+             "5\nHello\r\n0\r\n\r\n",        // bare LF after the size
+             "5;ext\nHello\r\n0\r\n\r\n",    // bare LF after the extension
+             "5\r\nHello\n0\r\n\r\n",        // bare LF after the data
+             "5\r\nHello0\r\n\r\n",          // no CRLF after the data
+             "5\r\nHello!\r\n0\r\n\r\n",     // the data is longer than its size
+             "5\r\nHello\r\r\n0\r\n\r\n",    // CR without LF
+             "5\r\nHello\r\n0\r\nA: b\n\r\n", // bare LF in the trailer
+             "\r\nHello\r\n0\r\n\r\n",       // no size
+             "5x\r\nHello\r\n0\r\n\r\n",     // not a hex digit
+             "FFFFFFFFFFFF\r\n",             // too big
+         }) {
+        for (size_t size{1}; size <= malformed.size(); ++size) {
+            if (!CHECK(decode(malformed, size).failed)) {
+                std::cerr << "  malformed body: " << malformed << '\n';
+                break;
+            }
+        }
+    }
+}
+
+// response of `server` to GET /, the body or the error
+std::pair<std::string, std::string> get(network::HttpClient& client,
+                                        tests::HttpServer const& server)
+{
+    std::promise<std::pair<std::string, std::string>> result;
+    client.sendRequest("127.0.0.1", server.port(), "/", "GET", {}, {},
+                       [&result](std::string const& body, std::string const& error) {
+                           result.set_value({body, error});
+                       });
+    return result.get_future().get();
+}
+
+void checkClient()
+{
+    // a failed request is not retried, the truncated response fails at once
+    common::Config::instance().setValue<int>(common::ConfigId::kHttpRetryCount, 0);
+    network::HttpClient client;
+
+    using tests::HttpServer;
+    auto const head{std::string{"HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"}};
+    auto const whole{HttpServer::Response{{head + std::string{kChunked}}}};
+    struct Case {
+        char const* name;
+        HttpServer::Response response;
+        std::chrono::microseconds pause{};
+    };
+    std::vector<Case> const cases{
+        {"whole", whole},
+        {"1-byte reads", HttpServer::split(whole, 1), std::chrono::microseconds{200}},
+        // the size line "19; quoted=..." is split between the reads
+        {"split size line", {{head + "5;name=value\r\nHello\r\n1", "9; quo", "ted=\"a;b\"\r",
+                              std::string{kChunked.substr(38)}}},
+         std::chrono::milliseconds{5}},
+        {"chunk per read", HttpServer::chunked({"Hello", ", the chunked body which ", "is ",
+                                                "complete"}),
+         std::chrono::milliseconds{1}},
+    };
+    for (auto const& test : cases) {
+        HttpServer server{[&test](std::string_view) { return test.response; }, test.pause};
+        auto const [body, error] = get(client, server);
+        if (!CHECK_EQ(body, kBody) || !CHECK_EQ(error, "")) {
+            std::cerr << "  response: " << test.name << '\n';
+        }
+    }
+
+    // the connection is closed in the middle of a chunk
+    HttpServer truncated{[&head](std::string_view) {
+        return HttpServer::Response{{head + "5\r\nHello\r\n19\r\n, the chunked"}, true};
+    }};
+    auto const [truncated_body, truncated_error] = get(client, truncated);
+    CHECK(truncated_body.empty());
+    CHECK(truncated_error.starts_with("Read content failed"));
+
+    HttpServer malformed{[&head](std::string_view) {
+        return HttpServer::Response{{head + "5\r\nHello\n0\r\n\r\n"}};
+    }};
+    auto const [malformed_body, malformed_error] = get(client, malformed);
+    CHECK(malformed_body.empty());
+    CHECK(malformed_error.contains("Chunked body is malformed"));
+}
+
+}  // namespace
+
+int main()
+{
+    // the decoder logs the malformed bodies, which are expected here
+    spdlog::set_level(spdlog::level::off);
+    checkDecoder();
+    checkClient();
+    std::cout << tests::failures() << " failures\n";
+    return tests::result();
+}
@@ -0,0 +1,179 @@
+#ifndef TESTS_HTTP_SERVER_H
+#define TESTS_HTTP_SERVER_H
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "asio.hpp"
+
+namespace tests {
+
+/**
+ * Local stand-in of an HTTP/1.1 server for the tests and the benchmarks of the HTTP client.
+ * It listens on 127.0.0.1 (port() is picked by the system) and serves the connections on its
+ * own thread: every request gets the response `respond` makes of the request head. The parts
+ * of the response are written one by one, `pause` apart, so the client gets them in separate
+ * reads; the connection is closed after the response if Response::close is set.
+ */
+class HttpServer final {
+public:
+    struct Response {
+        std::vector<std::string> parts;
+        bool close{false};
+    };
+    // gets the request line and the headers, without the body
+    using Respond = std::function<Response(std::string_view head)>;
+
+    explicit HttpServer(Respond respond, std::chrono::microseconds pause = {})
+        : respond_{std::move(respond)}
+        , pause_{pause}
+    {
+        acceptor_.open(asio::ip::tcp::v4());
+        acceptor_.set_option(asio::ip::tcp::acceptor::reuse_address{true});
+        acceptor_.bind({asio::ip::make_address("127.0.0.1"), 0});
+        acceptor_.listen();
+        port_ = std::to_string(acceptor_.local_endpoint().port());
+        asio::co_spawn(io_context_, accept(), asio::detached);
+        thread_ = std::thread{[this]() { io_context_.run(); }};
+    }
+
+    HttpServer(HttpServer const& other) = delete;
+    HttpServer& operator=(HttpServer const& other) = delete;
+
+    ~HttpServer()
+    {
+        io_context_.stop();
+        thread_.join();
+    }
+
+    std::string const& port() const { return port_; }
+    size_t connections() const { return connections_.load(); }
+    size_t requests() const { return requests_.load(); }
+
+    // "200 OK" response with the body of Content-Length
+    static Response ok(std::string_view body, bool close = false)
+    {
+        return {{std::format("HTTP/1.1 200 OK\r\nContent-Length: {}\r\n{}\r\n{}", body.size(),
+                             close ? "Connection: close\r\n" : "", body)},
+                close};
+    }
+
+    /**
+     * "200 OK" response whose chunked body is made of the parts; each part is one chunk
+     * and every chunk is written separately
+     */
+    static Response chunked(std::vector<std::string_view> const& parts)
+    {
+        Response response{{"HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"}};
+        for (auto const& part : parts) {
+            response.parts.push_back(std::format("{:x}\r\n{}\r\n", part.size(), part));
+        }
+        response.parts.emplace_back("0\r\n\r\n");
+        return response;
+    }
+
+    // the response split into parts of `size` bytes, so the client reads it piece by piece
+    static Response split(Response const& response, size_t size)
+    {
+        std::string whole;
+        for (auto const& part : response.parts) {
+            whole += part;
+        }
+        Response result{{}, response.close};
+        for (size_t pos{0}; pos < whole.size(); pos += size) {
+            result.parts.push_back(whole.substr(pos, size));
+        }
+        return result;
+    }
+
+private:
+    asio::io_context io_context_;
+    asio::ip::tcp::acceptor acceptor_{io_context_};
+    Respond respond_;
+    std::chrono::microseconds pause_;
+    std::string port_;
+    std::atomic<size_t> connections_{0};
+    std::atomic<size_t> requests_{0};
+    std::thread thread_;
+
+    asio::awaitable<void> accept()
+    {
+        for (;;) {
+            auto socket{co_await acceptor_.async_accept(asio::use_awaitable)};
+            ++connections_;
+            asio::error_code ignored;
+            socket.set_option(asio::ip::tcp::no_delay{true}, ignored);
+            asio::co_spawn(io_context_, serve(std::move(socket)), asio::detached);
+        }
+    }
+
+    asio::awaitable<void> serve(asio::ip::tcp::socket socket)
+    {
+        std::string buffer;
+        asio::steady_timer timer{io_context_};
+        asio::error_code ec;
+        while (!ec) {
+            auto const head_size{co_await asio::async_read_until(
+                socket, asio::dynamic_buffer(buffer), "\r\n\r\n",
+                asio::redirect_error(asio::use_awaitable, ec))};
+            if (ec) {
+                break;
+            }
+            auto const head{buffer.substr(0, head_size)};
+            auto const body_size{contentLength(head)};
+            if (buffer.size() < head_size + body_size) {
+                co_await asio::async_read(
+                    socket, asio::dynamic_buffer(buffer),
+                    asio::transfer_exactly(head_size + body_size - buffer.size()),
+                    asio::redirect_error(asio::use_awaitable, ec));
+                if (ec) {
+                    break;
+                }
+            }
+            buffer.erase(0, head_size + body_size);
+            ++requests_;
+
+            auto const response{respond_(head)};
+            for (auto const& part : response.parts) {
+                if (pause_.count() > 0) {
+                    timer.expires_after(pause_);
+                    co_await timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+                }
+                co_await asio::async_write(socket, asio::buffer(part),
+                                           asio::redirect_error(asio::use_awaitable, ec));
+                if (ec) {
+                    break;
+                }
+            }
+            if (response.close) {
+                break;
+            }
+        }
+        socket.close(ec);
+    }
+
+    static size_t contentLength(std::string_view head)
+    {
+        constexpr std::string_view kHeader{"\r\nContent-Length: "};
+        auto const pos{head.find(kHeader)};
+        size_t result{0};
+        if (pos != std::string_view::npos) {
+            auto const value{head.substr(pos + kHeader.size())};
+            std::from_chars(value.data(), value.data() + value.size(), result);
+        }
+        return result;
+    }
+};
+
+}  // namespace tests
+
+#endif  // TESTS_HTTP_SERVER_H
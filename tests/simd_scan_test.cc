@@ -0,0 +1,187 @@
+/**
+ * Differential test of the tools::simd scanners: every implementation supported by the
+ * CPU (scalar, SSE2, AVX2) is compared with the string_utils code the scanners have
+ * replaced. All the lengths up to a few AVX2 registers are checked with a blank
+ * (or a delimiter) at every position. The strings are cut out of a buffer guarded by
+ * the characters the scanners look for, so a read past the end gives a wrong result.
+ */
+
+#include <initializer_list>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "tests/check.h"
+#include "tools/simd_scan.h"
+#include "tools/string_utils.h"
+
+namespace {
+
+// the baseline: string_utils before it was vectorized ====
+
+std::vector<std::string> baselineSplit(std::string_view str, char delimiter)
+{
+    std::vector<std::string> tokens;
+    std::string token;
+    std::istringstream tokenStream(std::string{str});
+    while (std::getline(tokenStream, token, delimiter)) {
+        if (!token.empty()) {
+            tokens.push_back(token);
+        }
+    }
+    return tokens;
+}
+
+void baselineTrim(std::string& str)
+{
+    auto count{0UL};
+    while ((count != str.size()) && ((str.at(count) == ' ') || (str.at(count) == '\t'))) {
+        ++count;
+    }
+    str.erase(0, count);
+
+    auto index{str.size()};
+    while ((0 < index) && ((str.at(index - 1) == ' ') || (str.at(index - 1) == '\t') ||
+                           (str.at(index - 1) == '\n'))) {
+        --index;
+    }
+    if (index < str.size()) {
+        str.erase(index);
+    }
+}
+
+std::string_view baselineTrimmed(std::string_view str)
+{
+    auto const first{str.find_first_not_of(" \t")};
+    str = first == std::string_view::npos ? std::string_view{} : str.substr(first);
+    auto const last{str.find_last_not_of(" \t\n")};
+    return last == std::string_view::npos ? std::string_view{} : str.substr(0, last + 1);
+}
+
+// ========================================================
+
+constexpr size_t kMaxLength{70};
+constexpr char kBlanks[]{' ', '\t', '\n'};
+
+// `str` placed between `guard` characters, so the scanners can't stop at its ends by luck
+class Guarded {
+public:
+    Guarded(std::string_view str, char guard)
+        : buffer_(64, guard)
+    {
+        buffer_ += str;
+        buffer_ += std::string(64, guard);
+        view_ = std::string_view{buffer_}.substr(64, str.size());
+    }
+
+    std::string_view view() const { return view_; }
+
+private:
+    std::string buffer_;
+    std::string_view view_;
+};
+
+void checkFind(std::string_view str, char ch)
+{
+    Guarded const guarded{str, ch};
+    for (size_t pos{0}; pos <= str.size() + 1; ++pos) {
+        CHECK_EQ(tools::simd::find(guarded.view(), ch, pos), str.find(ch, pos));
+    }
+}
+
+void checkNotBlank(std::string_view str)
+{
+    Guarded const guarded{str, 'x'};
+    auto const view{guarded.view()};
+    using tools::simd::Blanks;
+    CHECK_EQ(tools::simd::findFirstNotBlank(view), str.find_first_not_of(" \t"));
+    CHECK_EQ(tools::simd::findFirstNotBlank(view, Blanks::kSpacesTabsAndNewLines),
+             str.find_first_not_of(" \t\n"));
+    CHECK_EQ(tools::simd::findLastNotBlank(view), str.find_last_not_of(" \t"));
+    CHECK_EQ(tools::simd::findLastNotBlank(view, Blanks::kSpacesTabsAndNewLines),
+             str.find_last_not_of(" \t\n"));
+}
+
+void checkStringUtils(std::string_view str, char delimiter)
+{
+    Guarded const guarded{str, delimiter};
+    CHECK(tools::string_utils::split(guarded.view(), delimiter) ==
+          baselineSplit(str, delimiter));
+
+    auto const views{tools::string_utils::splitView(guarded.view(), delimiter)};
+    auto const tokens{baselineSplit(str, delimiter)};
+    CHECK(std::vector<std::string>(views.begin(), views.end()) == tokens);
+
+    std::string trimmed{str};
+    tools::string_utils::trim(trimmed);
+    std::string expected{str};
+    baselineTrim(expected);
+    CHECK_EQ(trimmed, expected);
+    CHECK_EQ(tools::string_utils::trimmed(Guarded{str, 'x'}.view()), baselineTrimmed(str));
+}
+
+// strings of `length` made of `fill` with `ch` at `position` (none if it's past the end)
+std::string withCharAt(size_t length, char fill, char ch, size_t position)
+{
+    std::string result(length, fill);
+    if (position < length) {
+        result[position] = ch;
+    }
+    return result;
+}
+
+void checkAll()
+{
+    for (size_t length{0}; length <= kMaxLength; ++length) {
+        for (size_t position{0}; position <= length; ++position) {
+            for (auto const blank : kBlanks) {
+                // one blank among the letters and one letter among the blanks
+                auto const one_blank{withCharAt(length, 'a', blank, position)};
+                auto const one_letter{withCharAt(length, blank, 'a', position)};
+                // blanks up to the position, then letters and the other way round
+                auto const prefix{std::string(position, blank) +
+                                  std::string(length - position, 'a')};
+                auto const suffix{std::string(position, 'a') +
+                                  std::string(length - position, blank)};
+
+                for (auto const& str : {one_blank, one_letter, prefix, suffix}) {
+                    checkFind(str, blank);
+                    checkFind(str, 'a');
+                    checkNotBlank(str);
+                    checkStringUtils(str, blank);
+                    checkStringUtils(str, 'a');
+                }
+            }
+
+            // blanks of all kinds, so the mask combines several comparisons
+            std::string mixed(length, ' ');
+            for (size_t i{0}; i < length; ++i) {
+                mixed[i] = kBlanks[i % std::size(kBlanks)];
+            }
+            checkNotBlank(mixed);
+            checkNotBlank(withCharAt(length, '\n', ' ', position));
+            checkStringUtils(mixed, '\t');
+        }
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    using tools::simd::Implementation;
+    for (auto const implementation :
+         {Implementation::kScalar, Implementation::kSse2, Implementation::kAvx2}) {
+        if (!tools::simd::setImplementation(implementation)) {
+            std::cout << tools::simd::name(implementation) << ": not supported, skipped\n";
+            continue;
+        }
+        auto const failures{tests::failures()};
+        checkAll();
+        std::cout << tools::simd::name(implementation) << ": "
+                  << tests::failures() - failures << " failures\n";
+    }
+    return tests::result();
+}